@@ -13,21 +13,28 @@ Transaction::Transaction(double amt, const std::string& t, const std::string& ac
     auto now = chrono::system_clock::now();
     time_t now_time = chrono::system_clock::to_time_t(now);
     
-    // Cross-platform timestamp generation
-    char timeStr[100];
-    #ifdef _WIN32
-        ctime_s(timeStr, sizeof(timeStr), &now_time);
-    #else
-        ctime_r(&now_time, timeStr);
-    #endif
-    
-    timestamp = string(timeStr);
-    timestamp = timestamp.substr(0, timestamp.length() - 1); // Remove newline
+    // The text only changes once a second; reuse it within the same second
+    thread_local time_t cachedTime = 0;
+    thread_local string cachedTimestamp;
+    if (now_time != cachedTime || cachedTimestamp.empty()) {
+        // Cross-platform timestamp generation
+        char timeStr[100];
+        #ifdef _WIN32
+            ctime_s(timeStr, sizeof(timeStr), &now_time);
+        #else
+            ctime_r(&now_time, timeStr);
+        #endif
+        
+        cachedTimestamp = string(timeStr);
+        cachedTimestamp = cachedTimestamp.substr(0, cachedTimestamp.length() - 1); // Remove newline
+        cachedTime = now_time;
+    }
+    timestamp = cachedTimestamp;
 }
 
 // Getters
 double Transaction::getAmount() const { return amount; }
-string Transaction::getType() const { return type; }
+const string& Transaction::getType() const { return type; }
 string Transaction::getTimestamp() const { return timestamp; }
 string Transaction::getAccountType() const { return accountType; }
 
@@ -45,6 +52,8 @@ string Transaction::report() const {
         
         if (type == "FEE") {
             ss << " (Transaction Fee)";
+        } else if (type == "MAINTENANCE_FEE") {
+            ss << " (Monthly Maintenance Fee)";
         } else if (type == "INTEREST") {
             ss << " (Interest Added)";
         }
@@ -53,6 +62,199 @@ string Transaction::report() const {
     return ss.str();
 }
 
+// ============================
+// OperationDedupCache Class Implementation
+// ============================
+
+const uint32_t OperationDedupCache::EMPTY_SLOT;
+const size_t OperationDedupCache::SHORT_KEY;
+
+// Monotonic time in milliseconds; retention windows are long, so the coarse
+// clock is precise enough and much cheaper where available
+static int64_t coarseMillis() {
+    #ifdef CLOCK_MONOTONIC_COARSE
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+    #else
+        return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+// Hash of scope + "/" + operation id, computed without building the joined key
+static uint64_t operationHash(const string& scope, const string& operationId) {
+    uint64_t h = hash<string_view>()(scope) * 0x9e3779b97f4a7c15ull;
+    h ^= hash<string_view>()(operationId);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+// Whether a stored key is scope + "/" + operation id
+static bool keyMatches(const char* key, size_t length, const string& scope, const string& operationId) {
+    return length == scope.size() + 1 + operationId.size()
+        && memcmp(key, scope.data(), scope.size()) == 0
+        && key[scope.size()] == '/'
+        && memcmp(key + scope.size() + 1, operationId.data(), operationId.size()) == 0;
+}
+
+// Constructor with capacity and retention window
+OperationDedupCache::OperationDedupCache(size_t maxEntries, chrono::seconds retention)
+    : head(0), count(0),
+      capacity(maxEntries == 0 ? 1 : min<size_t>(maxEntries, EMPTY_SLOT - 1)),
+      windowMillis(chrono::duration_cast<chrono::milliseconds>(retention).count()) {
+}
+
+// Look up a completed operation; returns false if unknown or expired
+bool OperationDedupCache::lookup(const string& scope, const string& operationId, OperationResult& result) const {
+    size_t slot = findSlot(scope, operationId, operationHash(scope, operationId));
+    if (slot == string::npos) {
+        return false;
+    }
+    const Entry& entry = entries[index[slot].entry];
+    if (coarseMillis() - entry.recordedAt > windowMillis) {
+        return false;
+    }
+    result = entry.result;
+    return true;
+}
+
+// Remember the result of a completed operation
+void OperationDedupCache::record(const string& scope, const string& operationId, const OperationResult& result) {
+    int64_t now = coarseMillis();
+    evict(now);
+
+    uint64_t h = operationHash(scope, operationId);
+    if (findSlot(scope, operationId, h) != string::npos) {
+        return; // keep the original result
+    }
+    if (count == capacity) {
+        popOldest();
+    }
+
+    // Reuse a free ring slot, or grow the ring (straightened first so order is kept)
+    size_t position;
+    if (count < entries.size()) {
+        position = (head + count) % entries.size();
+    } else {
+        if (head != 0) {
+            rotate(entries.begin(), entries.begin() + head, entries.end());
+            head = 0;
+            rebuildIndex(index.size());
+        }
+        entries.emplace_back();
+        position = entries.size() - 1;
+    }
+
+    // Keep the index at most half full
+    if ((count + 1) * 2 > index.size()) {
+        rebuildIndex(max<size_t>(16, index.size() * 2));
+    }
+
+    Entry& entry = entries[position];
+    entry.keyLength = static_cast<uint32_t>(scope.size() + 1 + operationId.size());
+    char* key = entry.shortKey;
+    if (entry.keyLength > SHORT_KEY) {
+        entry.longKey.resize(entry.keyLength);
+        key = &entry.longKey[0];
+    } else {
+        entry.longKey.clear();
+    }
+    memcpy(key, scope.data(), scope.size());
+    key[scope.size()] = '/';
+    memcpy(key + scope.size() + 1, operationId.data(), operationId.size());
+    entry.hash = h;
+    entry.result = result;
+    entry.recordedAt = now;
+    indexInsert(h, static_cast<uint32_t>(position));
+    ++count;
+}
+
+// Number of operation ids currently remembered
+size_t OperationDedupCache::size() const {
+    return count;
+}
+
+// Forget every remembered operation id
+void OperationDedupCache::clear() {
+    entries.clear();
+    index.clear();
+    head = 0;
+    count = 0;
+}
+
+// Helper method to find the index slot holding a key; string::npos if absent
+size_t OperationDedupCache::findSlot(const string& scope, const string& operationId, uint64_t hash) const {
+    if (index.empty()) {
+        return string::npos;
+    }
+    size_t mask = index.size() - 1;
+    uint32_t tag = static_cast<uint32_t>(hash >> 32);
+    for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const IndexSlot& candidate = index[slot];
+        if (candidate.entry == EMPTY_SLOT) {
+            return string::npos;
+        }
+        const Entry& entry = entries[candidate.entry];
+        if (candidate.tag == tag && keyMatches(entry.key(), entry.keyLength, scope, operationId)) {
+            return slot;
+        }
+    }
+}
+
+// Helper method to add a ring slot to the index
+void OperationDedupCache::indexInsert(uint64_t hash, uint32_t entry) {
+    size_t mask = index.size() - 1;
+    size_t slot = hash & mask;
+    while (index[slot].entry != EMPTY_SLOT) {
+        slot = (slot + 1) & mask;
+    }
+    index[slot] = IndexSlot{static_cast<uint32_t>(hash >> 32), entry};
+}
+
+// Helper method to remove a ring slot from the index, shifting later probes back
+void OperationDedupCache::indexErase(uint64_t hash, uint32_t entry) {
+    size_t mask = index.size() - 1;
+    size_t hole = hash & mask;
+    while (index[hole].entry != entry) {
+        hole = (hole + 1) & mask;
+    }
+    for (size_t next = (hole + 1) & mask; index[next].entry != EMPTY_SLOT; next = (next + 1) & mask) {
+        // Move an entry back only if the hole lies between its home slot and where it sits
+        size_t home = entries[index[next].entry].hash & mask;
+        bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (movable) {
+            index[hole] = index[next];
+            hole = next;
+        }
+    }
+    index[hole].entry = EMPTY_SLOT;
+}
+
+// Helper method to rebuild the index at a given (power-of-two) size
+void OperationDedupCache::rebuildIndex(size_t slots) {
+    index.assign(slots, IndexSlot{0, EMPTY_SLOT});
+    for (size_t i = 0; i < count; ++i) {
+        size_t position = (head + i) % entries.size();
+        indexInsert(entries[position].hash, static_cast<uint32_t>(position));
+    }
+}
+
+// Helper method to drop the oldest entry
+void OperationDedupCache::popOldest() {
+    indexErase(entries[head].hash, static_cast<uint32_t>(head));
+    head = (head + 1) % entries.size();
+    --count;
+}
+
+// Helper method to drop entries that are too old
+void OperationDedupCache::evict(int64_t now) {
+    while (count > 0 && now - entries[head].recordedAt > windowMillis) {
+        popOldest();
+    }
+}
+
 // ============================
 // Account Class Implementation
 // ============================
@@ -60,14 +262,19 @@ string Transaction::report() const {
 // Constructor with validation for initial balance
 Account::Account(double initialBalance, const string& accNum, const string& accType) 
     : accountNumber(accNum.empty() ? generateAccountNumber() : accNum), 
-      accountTypeName(accType) {
+      accountTypeName(accType),
+      rules(getDefaultRules()),
+      snapshot(nullptr),
+      snapshotSlot(0) {
     try {
-        if (initialBalance >= 1000.00) {
+        if (initialBalance >= rules->getOpeningFloor()) {
             balance = initialBalance;
             // Log initial deposit - use accountTypeName instead of pure virtual function
             addToLog(Transaction(initialBalance, "INITIAL_DEPOSIT", accountTypeName));
         } else {
-            throw invalid_argument("The Initial Balance Must Be At Least $1000.00");
+            stringstream ss;
+            ss << "The Initial Balance Must Be At Least $" << fixed << setprecision(2) << rules->getOpeningFloor();
+            throw invalid_argument(ss.str());
         }
     } catch (const invalid_argument& e) {
         balance = 0.0;
@@ -84,6 +291,11 @@ void Account::Deposit(double amount) {
             throw invalid_argument("Invalid Deposit Amount!");
         }
         
+        RuleKind failed;
+        if (!rules->allowDeposit(amount, 0.0, failed)) {
+            throw runtime_error(describeRuleFailure(failed));
+        }
+        
         balance += amount;
         addToLog(Transaction(amount, "DEPOSIT", getAccountType()));
         cout << "Successfully Deposited: $" << fixed << setprecision(2) << amount << endl;
@@ -91,6 +303,9 @@ void Account::Deposit(double amount) {
     } catch (const invalid_argument& e) {
         cout << "Error: " << e.what() << endl;
         addToLog(Transaction(amount, "FAILED_DEPOSIT", getAccountType()));
+    } catch (const runtime_error& e) {
+        cout << "Error: " << e.what() << ". Deposit failed." << endl;
+        addToLog(Transaction(amount, "FAILED_DEPOSIT", getAccountType()));
     }
 }
 
@@ -101,12 +316,16 @@ void Account::Withdraw(double amount) {
             throw invalid_argument("Invalid Withdrawal Amount!");
         }
         
-        if (amount <= balance) {
+        RuleKind failed;
+        if (rules->allowWithdrawal(amount, 0.0, balance, ruleState, failed)) {
             balance -= amount;
+            rules->recordWithdrawal(amount, ruleState);
             addToLog(Transaction(amount, "WITHDRAWAL", getAccountType()));
             cout << "Successfully Withdrew: $" << fixed << setprecision(2) << amount << endl;
-        } else {
+        } else if (failed == RuleKind::OVERDRAFT_LIMIT) {
             throw runtime_error("Debit Amount Exceeded Account Balance");
+        } else {
+            throw runtime_error(describeRuleFailure(failed));
         }
         
     } catch (const invalid_argument& e) {
@@ -118,6 +337,116 @@ void Account::Withdraw(double amount) {
     }
 }
 
+// Deposit with a client-supplied operation id; a retried id returns the original result
+OperationResult Account::Deposit(double amount, const string& operationId) {
+    return applyOnce(operationId, true, amount);
+}
+
+// Withdraw with a client-supplied operation id; a retried id returns the original result
+OperationResult Account::Withdraw(double amount, const string& operationId) {
+    return applyOnce(operationId, false, amount);
+}
+
+// Shared cache of completed operation ids used by all accounts
+OperationDedupCache& Account::operationCache() {
+    static OperationDedupCache cache;
+    return cache;
+}
+
+// Helper method to apply a deposit/withdrawal at most once per operation id
+OperationResult Account::applyOnce(const string& operationId, bool isDeposit, double amount) {
+    OperationResult result{false, false, balance};
+
+    if (!operationId.empty() && operationCache().lookup(accountNumber, operationId, result)) {
+        result.replayed = true;
+        cout << "Duplicate Operation " << operationId << " Ignored. Returning Original Result." << endl;
+        return result;
+    }
+
+    // Dispatch through the virtual overrides so fees and checks still apply
+    size_t firstEntry = log.size();
+    if (isDeposit) {
+        Deposit(amount);
+    } else {
+        Withdraw(amount);
+    }
+
+    result.success = log.size() > firstEntry && log[firstEntry].getType().rfind("FAILED_", 0) != 0;
+    result.balance = balance;
+
+    if (!operationId.empty()) {
+        operationCache().record(accountNumber, operationId, result);
+    }
+    return result;
+}
+
+// Get the account number
+string Account::GetAccountNumber() const {
+    return accountNumber;
+}
+
+// Apply a compiled rule program to this account
+void Account::setRules(shared_ptr<const RuleProgram> program) {
+    if (!program) {
+        throw invalid_argument("Rule program cannot be null");
+    }
+    rules = program;
+}
+
+// Get the rule program in effect for this account
+shared_ptr<const RuleProgram> Account::getRules() const {
+    return rules;
+}
+
+// Publish this account's balance to a shared-memory snapshot after every transaction
+void Account::attachSnapshot(BalanceSnapshot& target) {
+    snapshotSlot = target.addAccount(accountNumber, accountTypeName);
+    snapshot = &target;
+    snapshot->publish(snapshotSlot, balance, log.size());
+}
+
+// Stop publishing to the attached snapshot (its slot keeps the last balance)
+void Account::detachSnapshot() {
+    snapshot = nullptr;
+    snapshotSlot = 0;
+}
+
+// Score every deposit and withdrawal with a fraud scorer (nullptr detaches it)
+void Account::attachFraudScorer(shared_ptr<FraudScorer> scorer) {
+    riskState.reset(scorer ? new AccountRiskState(scorer->makeState()) : nullptr);
+    fraudScorer = scorer;
+}
+
+// Rule program given to accounts created from now on (also sets the opening floor)
+static shared_ptr<const RuleProgram>& defaultRuleProgram() {
+    static shared_ptr<const RuleProgram> program = RuleProgram::defaults();
+    return program;
+}
+
+void Account::setDefaultRules(shared_ptr<const RuleProgram> program) {
+    if (!program) {
+        throw invalid_argument("Rule program cannot be null");
+    }
+    defaultRuleProgram() = program;
+}
+
+shared_ptr<const RuleProgram> Account::getDefaultRules() {
+    return defaultRuleProgram();
+}
+
+// Check whether a withdrawal would pass the account's rules, without applying it
+bool Account::CanWithdraw(double amount) const {
+    RuleState probe = ruleState;
+    RuleKind failed;
+    return amount > 0 && rules->allowWithdrawal(amount, 0.0, balance, probe, failed);
+}
+
+// Check whether a deposit would pass the account's rules, without applying it
+bool Account::CanDeposit(double amount) const {
+    RuleKind failed;
+    return amount > 0 && rules->allowDeposit(amount, 0.0, failed);
+}
+
 // Get current balance of the account
 double Account::GetBalance() const {
     // Log balance inquiry
@@ -128,6 +457,19 @@ double Account::GetBalance() const {
 // Helper method to add transaction to log
 void Account::addToLog(const Transaction& transaction) {
     log.push_back(transaction);
+    if (snapshot != nullptr) {
+        snapshot->publish(snapshotSlot, balance, log.size());
+    }
+    if (fraudScorer) {
+        const string& type = transaction.getType();
+        if (type == "DEPOSIT") {
+            fraudScorer->score(*riskState, accountNumber, ScoredEvent::DEPOSIT, transaction.getAmount());
+        } else if (type == "WITHDRAWAL") {
+            fraudScorer->score(*riskState, accountNumber, ScoredEvent::WITHDRAWAL, transaction.getAmount());
+        } else if (type == "FAILED_WITHDRAWAL") {
+            fraudScorer->score(*riskState, accountNumber, ScoredEvent::FAILED_WITHDRAWAL, transaction.getAmount());
+        }
+    }
 }
 
 // report() function as required - formats transaction information
@@ -213,7 +555,7 @@ string Account::getCurrentTimestamp() const {
 
 // Constructor inheriting from Account
 SavingsAccount::SavingsAccount(double initialBalance, double rate, const string& accNum) 
-    : Account(initialBalance, accNum, "SAVINGS"), interestRate(rate) {
+    : Account(initialBalance, accNum, "SAVINGS"), interestRate(rate), accruedInterest(0.0) {
 }
 
 // Calculate interest earned
@@ -237,6 +579,33 @@ void SavingsAccount::AddInterest() {
     }
 }
 
+// Accrue one day of interest (interest rate treated as annual) without crediting it
+void SavingsAccount::AccrueDailyInterest() {
+    accruedInterest += balance * (interestRate / 100.0) / 365.0;
+}
+
+// Credit accrued interest to the account
+void SavingsAccount::PostAccruedInterest() {
+    try {
+        if (accruedInterest > 0) {
+            double interest = accruedInterest;
+            accruedInterest = 0.0;
+            balance += interest;
+            addToLog(Transaction(interest, "INTEREST", getAccountType()));
+            cout << "Accrued interest of $" << fixed << setprecision(2) << interest
+                 << " posted to savings account. New balance: $" << balance << endl;
+        }
+    } catch (const exception& e) {
+        cout << "Error posting interest: " << e.what() << endl;
+        addToLog(Transaction(0.0, "FAILED_INTEREST", getAccountType()));
+    }
+}
+
+// Get interest accrued but not yet posted
+double SavingsAccount::GetAccruedInterest() const {
+    return accruedInterest;
+}
+
 // Get interest rate
 double SavingsAccount::GetInterestRate() const {
     return interestRate;
@@ -271,8 +640,10 @@ void ChequingAccount::Withdraw(double amount) {
         }
         
         double totalAmount = amount + transactionFee;
-        if (totalAmount <= balance) {
+        RuleKind failed;
+        if (rules->allowWithdrawal(amount, transactionFee, balance, ruleState, failed)) {
             balance -= totalAmount;
+            rules->recordWithdrawal(amount, ruleState);
             // Log withdrawal
             addToLog(Transaction(amount, "WITHDRAWAL", getAccountType()));
             // Log fee
@@ -281,8 +652,10 @@ void ChequingAccount::Withdraw(double amount) {
             cout << "Successfully Withdrew: $" << fixed << setprecision(2) << amount << endl;
             cout << "Transaction fee: $" << fixed << setprecision(2) << transactionFee << endl;
             cout << "Total deducted: $" << fixed << setprecision(2) << totalAmount << endl;
-        } else {
+        } else if (failed == RuleKind::OVERDRAFT_LIMIT) {
             throw runtime_error("Debit Amount + Fee Exceeded Account Balance");
+        } else {
+            throw runtime_error(describeRuleFailure(failed));
         }
         
     } catch (const invalid_argument& e) {
@@ -302,7 +675,8 @@ void ChequingAccount::Deposit(double amount) {
         }
         
         // Check if deposit covers the fee
-        if (amount > transactionFee) {
+        RuleKind failed;
+        if (rules->allowDeposit(amount, transactionFee, failed)) {
             balance += (amount - transactionFee);
             // Log deposit
             addToLog(Transaction(amount, "DEPOSIT", getAccountType()));
@@ -313,7 +687,7 @@ void ChequingAccount::Deposit(double amount) {
             cout << "Transaction fee charged: $" << fixed << setprecision(2) << transactionFee << endl;
             cout << "Net balance change: +$" << fixed << setprecision(2) << (amount - transactionFee) << endl;
         } else {
-            throw runtime_error("Deposit amount must exceed transaction fee");
+            throw runtime_error(describeRuleFailure(failed));
         }
         
     } catch (const invalid_argument& e) {
@@ -325,6 +699,42 @@ void ChequingAccount::Deposit(double amount) {
     }
 }
 
+// Charge a periodic maintenance fee
+void ChequingAccount::ChargeMaintenanceFee(double fee) {
+    try {
+        if (fee <= 0) {
+            return;
+        }
+        RuleKind failed;
+        if (!rules->allowCharge(fee, balance, failed)) {
+            throw runtime_error(failed == RuleKind::OVERDRAFT_LIMIT
+                                ? "Maintenance Fee Exceeded Account Balance"
+                                : describeRuleFailure(failed));
+        }
+
+        balance -= fee;
+        addToLog(Transaction(fee, "MAINTENANCE_FEE", getAccountType()));
+        cout << "Maintenance fee of $" << fixed << setprecision(2) << fee
+             << " charged. New balance: $" << balance << endl;
+
+    } catch (const runtime_error& e) {
+        cout << "Error: " << e.what() << ". Fee Not Charged." << endl;
+        addToLog(Transaction(fee, "FAILED_MAINTENANCE_FEE", getAccountType()));
+    }
+}
+
+// Override checks to include transaction fee
+bool ChequingAccount::CanWithdraw(double amount) const {
+    RuleState probe = ruleState;
+    RuleKind failed;
+    return amount > 0 && rules->allowWithdrawal(amount, transactionFee, balance, probe, failed);
+}
+
+bool ChequingAccount::CanDeposit(double amount) const {
+    RuleKind failed;
+    return amount > 0 && rules->allowDeposit(amount, transactionFee, failed);
+}
+
 // Get transaction fee
 double ChequingAccount::GetTransactionFee() const {
     return transactionFee;
@@ -11,18 +11,29 @@
 #include <ctime>
 #include <chrono>
 #include <limits>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+#include <memory>
+
+#include "Rules.h"
+#include "Snapshot.h"
+#include "Fraud.h"
 
 // Forward declarations
 class Transaction;
 class Account;
 class SavingsAccount;
 class ChequingAccount;
+class OperationDedupCache;
 
 // Transaction Class
 class Transaction {
 private:
     double amount;
-    std::string type; // "DEPOSIT", "WITHDRAWAL", "INTEREST", "FEE", "BALANCE_INQUIRY"
+    std::string type; // "DEPOSIT", "WITHDRAWAL", "INTEREST", "FEE", "MAINTENANCE_FEE", "BALANCE_INQUIRY"
     std::string timestamp;
     std::string accountType; // "SAVINGS" or "CHEQUING"
 
@@ -32,7 +43,7 @@ public:
     
     // Getters
     double getAmount() const;
-    std::string getType() const;
+    const std::string& getType() const;
     std::string getTimestamp() const;
     std::string getAccountType() const;
 
@@ -40,6 +51,79 @@ public:
     std::string report() const;
 };
 
+// Result of an operation submitted with a client-supplied operation id
+struct OperationResult {
+    bool success;   // true if the operation was applied
+    bool replayed;  // true if served from the dedup cache instead of being re-applied
+    double balance; // account balance right after the original operation
+};
+
+// OperationDedupCache Class
+// Bounded, time-windowed record of completed operation ids, keyed by account and
+// operation id. Entries live in a ring in insertion order, so the oldest entry is
+// always the next to expire; an open-addressed index of (hash tag, ring slot)
+// pairs finds them with one probe sequence and one key comparison.
+class OperationDedupCache {
+private:
+    static const size_t SHORT_KEY = 40;
+
+    // Key is scope + "/" + operation id, stored inline when short enough so a
+    // hit touches only the index slot and the entry
+    struct Entry {
+        uint64_t hash;
+        OperationResult result;
+        int64_t recordedAt; // milliseconds, coarse monotonic clock
+        uint32_t keyLength;
+        char shortKey[SHORT_KEY];
+        std::string longKey;
+
+        const char* key() const { return keyLength <= SHORT_KEY ? shortKey : longKey.data(); }
+    };
+
+    struct IndexSlot {
+        uint32_t tag;  // high bits of the key hash
+        uint32_t entry; // ring slot, EMPTY_SLOT if unused
+    };
+
+    static const uint32_t EMPTY_SLOT = 0xffffffffu;
+
+    std::vector<Entry> entries; // ring, grown on demand up to capacity
+    size_t head;                // oldest entry
+    size_t count;               // live entries
+    std::vector<IndexSlot> index; // power-of-two size, linear probing
+    size_t capacity;
+    int64_t windowMillis;
+
+    // Helper methods for the index
+    size_t findSlot(const std::string& scope, const std::string& operationId, uint64_t hash) const;
+    void indexInsert(uint64_t hash, uint32_t entry);
+    void indexErase(uint64_t hash, uint32_t entry);
+    void rebuildIndex(size_t slots);
+
+    // Helper method to drop the oldest entry
+    void popOldest();
+
+    // Helper method to drop entries that are too old
+    void evict(int64_t now);
+
+public:
+    // Constructor with capacity and retention window
+    OperationDedupCache(size_t maxEntries = 1000000,
+                        std::chrono::seconds retention = std::chrono::hours(24));
+
+    // Look up a completed operation; returns false if unknown or expired
+    bool lookup(const std::string& scope, const std::string& operationId, OperationResult& result) const;
+
+    // Remember the result of a completed operation
+    void record(const std::string& scope, const std::string& operationId, const OperationResult& result);
+
+    // Number of operation ids currently remembered
+    size_t size() const;
+
+    // Forget every remembered operation id
+    void clear();
+};
+
 // Account Base Class
 class Account {
 protected:
@@ -47,6 +131,12 @@ protected:
     std::vector<Transaction> log; // Transaction log as required
     std::string accountNumber;
     std::string accountTypeName; // Store account type as string
+    std::shared_ptr<const RuleProgram> rules; // Compiled limit rules
+    RuleState ruleState; // Running totals for daily and velocity rules
+    BalanceSnapshot* snapshot; // Shared-memory read view, if attached
+    uint32_t snapshotSlot;
+    std::shared_ptr<FraudScorer> fraudScorer; // Inline scoring stage, if attached
+    std::unique_ptr<AccountRiskState> riskState; // Streaming statistics for the scorer
 
     // Helper method to add transaction to log
     void addToLog(const Transaction& transaction);
@@ -60,6 +150,9 @@ protected:
     // Helper method to get account type for logging (used in constructor)
     virtual std::string getAccountTypeForLog() const { return "UNKNOWN"; }
 
+    // Helper method to apply a deposit/withdrawal at most once per operation id
+    OperationResult applyOnce(const std::string& operationId, bool isDeposit, double amount);
+
 public:
     // Constructor with validation for initial balance
     Account(double initialBalance, const std::string& accNum = "", const std::string& accType = "UNKNOWN");
@@ -72,7 +165,45 @@ public:
     
     // Withdraw money from account with balance check 
     virtual void Withdraw(double amount);
+
+    // Deposit with a client-supplied operation id; a retried id returns the original result
+    OperationResult Deposit(double amount, const std::string& operationId);
+
+    // Withdraw with a client-supplied operation id; a retried id returns the original result
+    OperationResult Withdraw(double amount, const std::string& operationId);
+
+    // Shared cache of completed operation ids used by all accounts
+    static OperationDedupCache& operationCache();
+
+    // Get the account number
+    std::string GetAccountNumber() const;
+
+    // Apply a compiled rule program to this account
+    void setRules(std::shared_ptr<const RuleProgram> program);
+
+    // Get the rule program in effect for this account
+    std::shared_ptr<const RuleProgram> getRules() const;
+
+    // Publish this account's balance to a shared-memory snapshot after every transaction.
+    // Only a pointer is kept: the snapshot must outlive the account, or be detached first
+    void attachSnapshot(BalanceSnapshot& target);
+
+    // Stop publishing to the attached snapshot (its slot keeps the last balance)
+    void detachSnapshot();
+
+    // Score every deposit and withdrawal with a fraud scorer (nullptr detaches it)
+    void attachFraudScorer(std::shared_ptr<FraudScorer> scorer);
+
+    // Rule program given to accounts created from now on (also sets the opening floor)
+    static void setDefaultRules(std::shared_ptr<const RuleProgram> program);
+    static std::shared_ptr<const RuleProgram> getDefaultRules();
     
+    // Check whether a withdrawal would pass the account's rules, without applying it
+    virtual bool CanWithdraw(double amount) const;
+
+    // Check whether a deposit would pass the account's rules, without applying it
+    virtual bool CanDeposit(double amount) const;
+
     // Get current balance of the account
     double GetBalance() const;
     
@@ -90,11 +221,16 @@ public:
 class SavingsAccount : public Account {
 private:
     double interestRate; // as percentage (e.g., 2.5 for 2.5%)
+    double accruedInterest; // accrued daily, credited when posted
 
     // Override helper method
     std::string getAccountTypeForLog() const override { return "SAVINGS"; }
 
 public:
+    // Keep the operation id overloads visible alongside the overrides
+    using Account::Deposit;
+    using Account::Withdraw;
+
     // Constructor inheriting from Account
     SavingsAccount(double initialBalance, double rate, const std::string& accNum = "");
     
@@ -104,6 +240,15 @@ public:
     // Add interest to the account
     void AddInterest();
     
+    // Accrue one day of interest (interest rate treated as annual) without crediting it
+    void AccrueDailyInterest();
+
+    // Credit accrued interest to the account
+    void PostAccruedInterest();
+
+    // Get interest accrued but not yet posted
+    double GetAccruedInterest() const;
+
     // Get interest rate
     double GetInterestRate() const;
     
@@ -123,6 +268,10 @@ private:
     std::string getAccountTypeForLog() const override { return "CHEQUING"; }
 
 public:
+    // Keep the operation id overloads visible alongside the overrides
+    using Account::Deposit;
+    using Account::Withdraw;
+
     // Constructor inheriting from Account
     ChequingAccount(double initialBalance, double fee, const std::string& accNum = "");
     
@@ -131,7 +280,14 @@ public:
     
     // Override Deposit to include transaction fee
     void Deposit(double amount) override;
+
+    // Override checks to include transaction fee
+    bool CanWithdraw(double amount) const override;
+    bool CanDeposit(double amount) const override;
     
+    // Charge a periodic maintenance fee
+    void ChargeMaintenanceFee(double fee);
+
     // Get transaction fee
     double GetTransactionFee() const;
     
@@ -147,4 +303,20 @@ void displayMainMenu();
 void displayAccountMenu(const std::string& accountType);
 void displayAccountInfo(Account* account, SavingsAccount* savings = nullptr, ChequingAccount* chequing = nullptr);
 
+// ConsoleMute Class
+// Silences std::cout (account operation messages) for the lifetime of the object
+class ConsoleMute {
+private:
+    std::streambuf* saved;
+
+public:
+    ConsoleMute() : saved(std::cout.rdbuf(nullptr)) {}
+    ~ConsoleMute() {
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+    }
+    ConsoleMute(const ConsoleMute&) = delete;
+    ConsoleMute& operator=(const ConsoleMute&) = delete;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "BulkLoader.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+using namespace std;
+
+static const char SEED_MAGIC[8] = {'T', 'R', 'J', 'J', 'S', 'E', 'E', 'D'};
+
+// Helper to parse a decimal amount. strtod alone would also take leading spaces,
+// hex ("0x10"), "inf" and "nan", none of which belong in a seed file.
+static bool parseAmount(const string& text, double& value) {
+    if (text.empty()) {
+        return false;
+    }
+    for (char c : text) {
+        if (!((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E')) {
+            return false;
+        }
+    }
+    char* parsed;
+    value = strtod(text.c_str(), &parsed);
+    return *parsed == '\0';
+}
+
+// Helper to parse one CSV line into a seed; returns an error message or "" on success
+static string parseSeedLine(const char* begin, const char* end, AccountSeed& seed) {
+    string line(begin, end);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+
+    string fields[4];
+    size_t field = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= line.size() && field < 4; ++i) {
+        if (i == line.size() || line[i] == ',') {
+            fields[field++] = line.substr(start, i - start);
+            start = i + 1;
+        }
+    }
+    if (field != 4 || start <= line.size()) {
+        return "expected 4 fields";
+    }
+
+    memset(&seed, 0, sizeof(seed));
+    const string& type = fields[0];
+    if (type == "S" || type == "SAVINGS") {
+        seed.type = 'S';
+    } else if (type == "C" || type == "CHEQUING") {
+        seed.type = 'C';
+    } else {
+        return "unknown account type '" + type + "'";
+    }
+
+    if (fields[1].empty() || fields[1].size() >= sizeof(seed.accountNumber)) {
+        return "missing or too long account number";
+    }
+    memcpy(seed.accountNumber, fields[1].c_str(), fields[1].size());
+
+    if (!parseAmount(fields[2], seed.openingBalance)) {
+        return "invalid opening balance";
+    }
+    if (!parseAmount(fields[3], seed.rateOrFee)) {
+        return "invalid rate or fee";
+    }
+    return "";
+}
+
+// ============================
+// BulkLoadResult Implementation
+// ============================
+
+// Accounts created per second, parse and build together
+double BulkLoadResult::accountsPerSecond() const {
+    double seconds = parseSeconds + buildSeconds;
+    return seconds > 0.0 ? accounts.size() / seconds : 0.0;
+}
+
+// Print the load summary
+void BulkLoadResult::print(ostream& out) const {
+    out << "\n=== BULK LOAD REPORT ===" << endl;
+    out << "Accounts Created: " << accounts.size() << endl;
+    out << "Records Rejected: " << errors.size() << endl;
+    for (size_t i = 0; i < errors.size() && i < 10; ++i) {
+        out << "  " << errors[i] << endl;
+    }
+    if (errors.size() > 10) {
+        out << "  ... " << errors.size() - 10 << " more" << endl;
+    }
+    out << "Parse: " << fixed << setprecision(3) << parseSeconds << " s  Build: " << buildSeconds << " s" << endl;
+    out << "Throughput: " << fixed << setprecision(0) << accountsPerSecond() << " accounts/s" << endl;
+    out << "========================" << endl;
+}
+
+// ============================
+// BulkLoader Class Implementation
+// ============================
+
+// Constructor with a worker thread count (0 = one per hardware thread)
+BulkLoader::BulkLoader(unsigned threadCount)
+    : threads(threadCount != 0 ? threadCount : max(1u, thread::hardware_concurrency())) {
+}
+
+// Parse a CSV seed file; lines, if given, receives each seed's line number in the file
+vector<AccountSeed> BulkLoader::parseCsv(const string& filename, vector<string>& errors, vector<size_t>* lines) const {
+    ifstream inFile(filename, ios::binary | ios::ate);
+    if (!inFile.is_open()) {
+        throw runtime_error("Unable to open seed file: " + filename);
+    }
+    string data(static_cast<size_t>(inFile.tellg()), '\0');
+    inFile.seekg(0);
+    inFile.read(&data[0], static_cast<streamsize>(data.size()));
+
+    // Skip an optional header line
+    size_t bodyStart = 0;
+    if (data.compare(0, 4, "type") == 0) {
+        size_t newline = data.find('\n');
+        bodyStart = newline == string::npos ? data.size() : newline + 1;
+    }
+
+    // Split the body into one chunk per thread, each ending on a line boundary
+    vector<size_t> bounds(threads + 1, data.size());
+    bounds[0] = bodyStart;
+    for (unsigned t = 1; t < threads; ++t) {
+        size_t guess = bodyStart + (data.size() - bodyStart) * t / threads;
+        size_t newline = data.find('\n', max(guess, bounds[t - 1]));
+        bounds[t] = newline == string::npos ? data.size() : newline + 1;
+    }
+
+    struct ChunkError {
+        size_t line; // line within the chunk
+        string message;
+    };
+    vector<vector<AccountSeed>> chunkSeeds(threads);
+    vector<vector<size_t>> chunkSeedLines(threads); // line within the chunk of each seed
+    vector<vector<ChunkError>> chunkErrors(threads);
+    vector<size_t> chunkLines(threads, 0);
+
+    parallelFor(threads, [&](unsigned, size_t first, size_t last) {
+        for (size_t t = first; t < last; ++t) {
+            const char* p = data.data() + bounds[t];
+            const char* end = data.data() + bounds[t + 1];
+            chunkSeeds[t].reserve((end - p) / 24);
+            while (p < end) {
+                const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+                if (lineEnd == nullptr) {
+                    lineEnd = end;
+                }
+                ++chunkLines[t];
+                if (lineEnd > p && !(lineEnd - p == 1 && *p == '\r')) {
+                    AccountSeed seed;
+                    string error = parseSeedLine(p, lineEnd, seed);
+                    if (error.empty()) {
+                        chunkSeeds[t].push_back(seed);
+                        chunkSeedLines[t].push_back(chunkLines[t]);
+                    } else {
+                        chunkErrors[t].push_back({chunkLines[t], error});
+                    }
+                }
+                p = lineEnd + 1;
+            }
+        }
+    });
+
+    // Stitch chunks back together in file order
+    vector<AccountSeed> seeds;
+    size_t total = 0;
+    for (const auto& chunk : chunkSeeds) {
+        total += chunk.size();
+    }
+    seeds.reserve(total);
+    if (lines) {
+        lines->clear();
+        lines->reserve(total);
+    }
+    size_t lineOffset = bodyStart > 0 ? 1 : 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        seeds.insert(seeds.end(), chunkSeeds[t].begin(), chunkSeeds[t].end());
+        if (lines) {
+            for (size_t line : chunkSeedLines[t]) {
+                lines->push_back(lineOffset + line);
+            }
+        }
+        for (const auto& error : chunkErrors[t]) {
+            errors.push_back("Line " + to_string(lineOffset + error.line) + ": " + error.message);
+        }
+        lineOffset += chunkLines[t];
+    }
+    return seeds;
+}
+
+// Read a binary seed file
+vector<AccountSeed> BulkLoader::readBinary(const string& filename) {
+    ifstream inFile(filename, ios::binary);
+    if (!inFile.is_open()) {
+        throw runtime_error("Unable to open seed file: " + filename);
+    }
+
+    SeedFileHeader header;
+    if (!inFile.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || memcmp(header.magic, SEED_MAGIC, sizeof(SEED_MAGIC)) != 0) {
+        throw runtime_error("Not a binary seed file: " + filename);
+    }
+
+    // Check the header's count against the file size before allocating for it
+    inFile.seekg(0, ios::end);
+    uint64_t remaining = static_cast<uint64_t>(inFile.tellg()) - sizeof(header);
+    inFile.seekg(sizeof(header));
+    if (header.count > remaining / sizeof(AccountSeed)) {
+        throw runtime_error("Binary seed file is truncated: " + filename);
+    }
+
+    vector<AccountSeed> seeds(header.count);
+    if (!inFile.read(reinterpret_cast<char*>(seeds.data()), static_cast<streamsize>(seeds.size() * sizeof(AccountSeed)))) {
+        throw runtime_error("Binary seed file is truncated: " + filename);
+    }
+    return seeds;
+}
+
+// Write seeds as a binary seed file
+bool BulkLoader::writeBinary(const vector<AccountSeed>& seeds, const string& filename) {
+    ofstream outFile(filename, ios::binary);
+    if (!outFile.is_open()) {
+        cout << "Error: Unable to open file for writing: " << filename << endl;
+        return false;
+    }
+
+    SeedFileHeader header;
+    memcpy(header.magic, SEED_MAGIC, sizeof(SEED_MAGIC));
+    header.count = seeds.size();
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(reinterpret_cast<const char*>(seeds.data()), static_cast<streamsize>(seeds.size() * sizeof(AccountSeed)));
+    return static_cast<bool>(outFile);
+}
+
+// Validate seeds and construct their accounts with opening entries
+BulkLoadResult BulkLoader::build(const vector<AccountSeed>& seeds, const vector<size_t>* lines) const {
+    if (lines && lines->size() != seeds.size()) {
+        throw invalid_argument("Need one line number per seed");
+    }
+    BulkLoadResult result;
+
+    // Where a seed came from, as operators will look for it: its CSV line, or its binary record
+    auto position = [&](size_t i) {
+        return lines ? "Line " + to_string((*lines)[i]) : "Record " + to_string(i + 1);
+    };
+    double floor = Account::getDefaultRules()->getOpeningFloor();
+
+    vector<vector<unique_ptr<Account>>> built(threads);
+    vector<vector<string>> rejected(threads);
+
+    auto start = chrono::steady_clock::now();
+
+    // Account numbers must be unique within the load; the first record with a number wins.
+    // A flat open-addressed table of record indexes (0 = empty) keeps this pass allocation-free.
+    vector<size_t> firstWithNumber(seeds.size());
+    if (seeds.size() >= numeric_limits<uint32_t>::max()) {
+        throw runtime_error("Too many records for one load");
+    }
+    {
+        size_t slots = 16;
+        while (slots < seeds.size() * 2) {
+            slots *= 2;
+        }
+        vector<uint32_t> table(slots, 0);
+        for (size_t i = 0; i < seeds.size(); ++i) {
+            const char* number = seeds[i].accountNumber;
+            size_t length = strnlen(number, sizeof(seeds[i].accountNumber));
+            size_t slot = hash<string_view>()(string_view(number, length)) & (slots - 1);
+            firstWithNumber[i] = i;
+            while (table[slot] != 0) {
+                const char* other = seeds[table[slot] - 1].accountNumber;
+                if (strnlen(other, sizeof(seeds[i].accountNumber)) == length && memcmp(other, number, length) == 0) {
+                    firstWithNumber[i] = table[slot] - 1;
+                    break;
+                }
+                slot = (slot + 1) & (slots - 1);
+            }
+            if (table[slot] == 0) {
+                table[slot] = static_cast<uint32_t>(i + 1);
+            }
+        }
+    }
+
+    parallelFor(seeds.size(), [&](unsigned t, size_t first, size_t last) {
+        built[t].reserve(last - first);
+        for (size_t i = first; i < last; ++i) {
+            const AccountSeed& seed = seeds[i];
+            string number(seed.accountNumber, strnlen(seed.accountNumber, sizeof(seed.accountNumber)));
+            string record = position(i);
+
+            // Same checks the constructor and main() apply, without the console warnings.
+            // Written so NaN fails them: a NaN compares false against everything.
+            if (number.empty()) {
+                rejected[t].push_back(record + ": missing account number");
+            } else if (firstWithNumber[i] != i) {
+                rejected[t].push_back(record + " (" + number + "): duplicate account number, already used by "
+                                      + position(firstWithNumber[i]));
+            } else if (!isfinite(seed.openingBalance) || !(seed.openingBalance >= floor)) {
+                rejected[t].push_back(record + " (" + number + "): opening balance below minimum or not a number");
+            } else if (!isfinite(seed.rateOrFee) || !(seed.rateOrFee >= 0)) {
+                rejected[t].push_back(record + " (" + number + (seed.type == 'S'
+                    ? "): negative or invalid interest rate" : "): negative or invalid transaction fee"));
+            } else if (seed.type == 'S') {
+                built[t].emplace_back(new SavingsAccount(seed.openingBalance, seed.rateOrFee, number));
+            } else if (seed.type == 'C') {
+                built[t].emplace_back(new ChequingAccount(seed.openingBalance, seed.rateOrFee, number));
+            } else {
+                rejected[t].push_back(record + " (" + number + "): unknown account type");
+            }
+        }
+    });
+
+    result.accounts.reserve(seeds.size());
+    for (unsigned t = 0; t < threads; ++t) {
+        for (auto& account : built[t]) {
+            result.accounts.push_back(move(account));
+        }
+        result.errors.insert(result.errors.end(), rejected[t].begin(), rejected[t].end());
+    }
+    result.buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// Load a seed file, detecting binary files by their header
+BulkLoadResult BulkLoader::load(const string& filename) const {
+    char magic[sizeof(SEED_MAGIC)] = {};
+    {
+        ifstream probe(filename, ios::binary);
+        if (!probe.is_open()) {
+            throw runtime_error("Unable to open seed file: " + filename);
+        }
+        probe.read(magic, sizeof(magic));
+    }
+    bool binary = memcmp(magic, SEED_MAGIC, sizeof(SEED_MAGIC)) == 0;
+
+    vector<string> parseErrors;
+    vector<size_t> lines;
+    auto start = chrono::steady_clock::now();
+    vector<AccountSeed> seeds = binary ? readBinary(filename) : parseCsv(filename, parseErrors, &lines);
+    double parseSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    BulkLoadResult result = build(seeds, binary ? nullptr : &lines);
+    result.parseSeconds = parseSeconds;
+    result.errors.insert(result.errors.begin(), parseErrors.begin(), parseErrors.end());
+    return result;
+}
+
+// Helper method to split [0, count) into one range per thread and run work on each
+void BulkLoader::parallelFor(size_t count, const function<void(unsigned, size_t, size_t)>& work) const {
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t first = count * t / threads;
+        size_t last = count * (t + 1) / threads;
+        if (t + 1 == threads) {
+            work(t, first, last); // the calling thread takes the last range
+        } else {
+            workers.emplace_back(work, t, first, last);
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef BULKLOADER_H
+#define BULKLOADER_H
+
+#include "Banking.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+// One account to provision. The layout doubles as the binary seed file record.
+struct AccountSeed {
+    uint8_t type;             // 'S' = savings, 'C' = chequing
+    char accountNumber[23];
+    double openingBalance;
+    double rateOrFee;         // interest rate for savings, transaction fee for chequing
+};
+static_assert(sizeof(AccountSeed) == 40, "AccountSeed is also the binary record layout");
+
+// Binary seed file header, followed by count AccountSeed records
+struct SeedFileHeader {
+    char magic[8];            // "TRJJSEED"
+    uint64_t count;
+};
+
+// Outcome of a bulk load
+struct BulkLoadResult {
+    std::vector<std::unique_ptr<Account>> accounts;
+    std::vector<std::string> errors; // one line per rejected record
+    double parseSeconds = 0.0;
+    double buildSeconds = 0.0;
+
+    // Accounts created per second, parse and build together
+    double accountsPerSecond() const;
+
+    // Print the load summary
+    void print(std::ostream& out) const;
+};
+
+// BulkLoader Class
+// Provisions many accounts at once from a seed file, either CSV
+// (type,accountNumber,openingBalance,rateOrFee with type S or C) or the binary
+// format written by writeBinary. Records are parsed and accounts constructed in
+// parallel chunks; records that would fail the Account constructor's checks, or
+// that repeat an account number, are rejected up front, so no per-account
+// console output is produced.
+class BulkLoader {
+private:
+    unsigned threads;
+
+    // Helper method to split [0, count) into one range per thread and run work on each
+    void parallelFor(size_t count, const std::function<void(unsigned, size_t, size_t)>& work) const;
+
+public:
+    // Constructor with a worker thread count (0 = one per hardware thread)
+    explicit BulkLoader(unsigned threadCount = 0);
+
+    // Parse a CSV seed file; lines, if given, receives each seed's line number in the file
+    std::vector<AccountSeed> parseCsv(const std::string& filename, std::vector<std::string>& errors,
+                                      std::vector<size_t>* lines = nullptr) const;
+
+    // Read a binary seed file
+    static std::vector<AccountSeed> readBinary(const std::string& filename);
+
+    // Write seeds as a binary seed file
+    static bool writeBinary(const std::vector<AccountSeed>& seeds, const std::string& filename);
+
+    // Validate seeds and construct their accounts with opening entries. Rejects name
+    // the seed's CSV line when lines is given, otherwise its record number
+    BulkLoadResult build(const std::vector<AccountSeed>& seeds, const std::vector<size_t>* lines = nullptr) const;
+
+    // Load a seed file, detecting binary files by their header
+    BulkLoadResult load(const std::string& filename) const;
+};
+
+#endif
@@ -0,0 +1,257 @@
+#include "Fraud.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+const uint32_t AccountRiskState::MAX_BURST;
+
+// Marks an unused slot in the failure-time ring
+static const int64_t NO_TIME = numeric_limits<int64_t>::min();
+
+// One in this many scored events is timed
+static const uint64_t TIMING_SAMPLE_MASK = 1023;
+
+// Monotonic time in milliseconds, for burst windows
+static int64_t currentMillis() {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Name of a signal for logs and reports
+string fraudSignalName(FraudSignal signal) {
+    switch (signal) {
+        case FraudSignal::LARGE_DEPOSIT:           return "LARGE_DEPOSIT";
+        case FraudSignal::LARGE_WITHDRAWAL:        return "LARGE_WITHDRAWAL";
+        case FraudSignal::DEPOSIT_ABOVE_QUANTILE:  return "DEPOSIT_ABOVE_QUANTILE";
+        case FraudSignal::FAILED_WITHDRAWAL_BURST: return "FAILED_WITHDRAWAL_BURST";
+    }
+    return "UNKNOWN";
+}
+
+// ============================
+// P2Quantile Class Implementation
+// ============================
+
+// Constructor for quantile p (0 < p < 1)
+P2Quantile::P2Quantile(double p) : count(0) {
+    for (int i = 0; i < 5; ++i) {
+        heights[i] = 0.0;
+        positions[i] = i + 1;
+    }
+    desired[0] = 1.0;
+    desired[1] = 1.0 + 2.0 * p;
+    desired[2] = 1.0 + 4.0 * p;
+    desired[3] = 3.0 + 2.0 * p;
+    desired[4] = 5.0;
+    increments[0] = 0.0;
+    increments[1] = p / 2.0;
+    increments[2] = p;
+    increments[3] = (1.0 + p) / 2.0;
+    increments[4] = 1.0;
+}
+
+// Add one observation
+void P2Quantile::add(double x) {
+    // The first five observations seed the markers
+    if (count < 5) {
+        heights[count++] = x;
+        if (count == 5) {
+            sort(heights, heights + 5);
+        }
+        return;
+    }
+    ++count;
+
+    // Find the cell x falls into, stretching the end markers if needed
+    int cell;
+    if (x < heights[0]) {
+        heights[0] = x;
+        cell = 0;
+    } else if (x >= heights[4]) {
+        heights[4] = x;
+        cell = 3;
+    } else {
+        cell = 0;
+        while (cell < 3 && x >= heights[cell + 1]) {
+            ++cell;
+        }
+    }
+
+    for (int i = cell + 1; i < 5; ++i) {
+        positions[i] += 1.0;
+    }
+    for (int i = 0; i < 5; ++i) {
+        desired[i] += increments[i];
+    }
+
+    // Move the middle markers towards their desired positions
+    for (int i = 1; i < 4; ++i) {
+        double offset = desired[i] - positions[i];
+        if ((offset >= 1.0 && positions[i + 1] - positions[i] > 1.0)
+            || (offset <= -1.0 && positions[i - 1] - positions[i] < -1.0)) {
+            double step = offset > 0 ? 1.0 : -1.0;
+
+            // Piecewise-parabolic prediction, falling back to linear if it leaves the bracket
+            double parabolic = heights[i] + step / (positions[i + 1] - positions[i - 1])
+                * ((positions[i] - positions[i - 1] + step) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i])
+                 + (positions[i + 1] - positions[i] - step) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1]));
+            if (heights[i - 1] < parabolic && parabolic < heights[i + 1]) {
+                heights[i] = parabolic;
+            } else {
+                int j = i + static_cast<int>(step);
+                heights[i] += step * (heights[j] - heights[i]) / (positions[j] - positions[i]);
+            }
+            positions[i] += step;
+        }
+    }
+}
+
+// Current estimate (0 until five observations have been seen)
+double P2Quantile::estimate() const {
+    return count < 5 ? 0.0 : heights[2];
+}
+
+// ============================
+// AccountRiskState Implementation
+// ============================
+
+AccountRiskState::AccountRiskState(double quantile)
+    : depositQuantile(quantile), failedHead(0) {
+    fill(failedWithdrawalTimes, failedWithdrawalTimes + MAX_BURST, NO_TIME);
+}
+
+// Helper to fold one amount into an exponentially weighted mean and variance
+static void updateEwma(EwmaStats& stats, double amount, double alpha) {
+    if (stats.count++ == 0) {
+        stats.mean = amount;
+        stats.variance = 0.0;
+        return;
+    }
+    double diff = amount - stats.mean;
+    double increment = alpha * diff;
+    stats.mean += increment;
+    stats.variance = (1.0 - alpha) * (stats.variance + diff * increment);
+}
+
+// Helper to score an amount against running stats; returns the z-score (0 while warming up)
+static double zScore(const EwmaStats& stats, double amount, uint32_t warmup) {
+    if (stats.count < warmup || stats.count == 0) {
+        return 0.0;
+    }
+    // Floor the deviation at 1% of the mean so perfectly steady streams don't flag on small changes
+    double deviation = max(sqrt(stats.variance), 0.01 * fabs(stats.mean));
+    return deviation > 0.0 ? (amount - stats.mean) / deviation : 0.0;
+}
+
+// ============================
+// FraudScorer Class Implementation
+// ============================
+
+// Constructor with thresholds and the callback that receives flags
+FraudScorer::FraudScorer(const FraudConfig& cfg, FlagCallback callback)
+    : config(cfg), onFlag(move(callback)),
+      eventsScored(0), flagsRaised(0), sampledEvents(0), sampledNanos(0), maxNanos(0) {
+    if (config.ewmaAlpha <= 0.0 || config.ewmaAlpha > 1.0) {
+        throw invalid_argument("EWMA weight must be in (0, 1]");
+    }
+    if (config.quantile <= 0.0 || config.quantile >= 1.0) {
+        throw invalid_argument("Tracked quantile must be in (0, 1)");
+    }
+    if (config.failedBurstCount < 1 || config.failedBurstCount > AccountRiskState::MAX_BURST) {
+        throw invalid_argument("Failed withdrawal burst count must be between 1 and "
+                               + to_string(AccountRiskState::MAX_BURST));
+    }
+}
+
+// Fresh per-account state matching this scorer's config
+AccountRiskState FraudScorer::makeState() const {
+    return AccountRiskState(config.quantile);
+}
+
+// Score one event against an account's state, then fold it into the state
+void FraudScorer::score(AccountRiskState& state, const string& accountNumber, ScoredEvent event, double amount) {
+    uint64_t sequence = eventsScored.fetch_add(1, memory_order_relaxed);
+    if ((sequence & TIMING_SAMPLE_MASK) != 0) {
+        evaluate(state, accountNumber, event, amount);
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
+    evaluate(state, accountNumber, event, amount);
+    uint64_t nanos = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+    sampledEvents.fetch_add(1, memory_order_relaxed);
+    sampledNanos.fetch_add(nanos, memory_order_relaxed);
+    uint64_t seen = maxNanos.load(memory_order_relaxed);
+    while (nanos > seen && !maxNanos.compare_exchange_weak(seen, nanos, memory_order_relaxed)) {
+    }
+}
+
+// Helper method that does the actual scoring
+void FraudScorer::evaluate(AccountRiskState& state, const string& accountNumber, ScoredEvent event, double amount) {
+    switch (event) {
+        case ScoredEvent::DEPOSIT: {
+            // Score against what was seen before this deposit, then learn from it
+            double z = zScore(state.deposits, amount, config.warmupEvents);
+            if (z > config.zScoreThreshold) {
+                raise(accountNumber, FraudSignal::LARGE_DEPOSIT, amount, z);
+            }
+            double high = state.depositQuantile.estimate();
+            if (state.deposits.count >= config.warmupEvents && high > 0.0
+                && amount > config.quantileMultiplier * high) {
+                raise(accountNumber, FraudSignal::DEPOSIT_ABOVE_QUANTILE, amount, amount / high);
+            }
+            updateEwma(state.deposits, amount, config.ewmaAlpha);
+            state.depositQuantile.add(amount);
+            break;
+        }
+
+        case ScoredEvent::WITHDRAWAL: {
+            double z = zScore(state.withdrawals, amount, config.warmupEvents);
+            if (z > config.zScoreThreshold) {
+                raise(accountNumber, FraudSignal::LARGE_WITHDRAWAL, amount, z);
+            }
+            updateEwma(state.withdrawals, amount, config.ewmaAlpha);
+            break;
+        }
+
+        case ScoredEvent::FAILED_WITHDRAWAL: {
+            const uint32_t ringSize = AccountRiskState::MAX_BURST;
+            int64_t now = currentMillis();
+            state.failedWithdrawalTimes[state.failedHead] = now;
+            state.failedHead = (state.failedHead + 1) % ringSize;
+
+            // Oldest of the last failedBurstCount failures
+            int64_t oldest = state.failedWithdrawalTimes[(state.failedHead + ringSize - config.failedBurstCount) % ringSize];
+            if (oldest != NO_TIME && now - oldest <= static_cast<int64_t>(config.failedBurstSeconds) * 1000) {
+                raise(accountNumber, FraudSignal::FAILED_WITHDRAWAL_BURST, amount, config.failedBurstCount);
+                // Start counting afresh so one burst raises one flag
+                fill(state.failedWithdrawalTimes, state.failedWithdrawalTimes + ringSize, NO_TIME);
+            }
+            break;
+        }
+    }
+}
+
+// Helper method to raise a flag through the callback
+void FraudScorer::raise(const string& accountNumber, FraudSignal signal, double amount, double score) {
+    flagsRaised.fetch_add(1, memory_order_relaxed);
+    if (onFlag) {
+        onFlag(FraudFlag{accountNumber, signal, amount, score});
+    }
+}
+
+// Snapshot of the stage's counters and measured overhead
+FraudStats FraudScorer::getStats() const {
+    FraudStats stats;
+    stats.eventsScored = eventsScored.load(memory_order_relaxed);
+    stats.flagsRaised = flagsRaised.load(memory_order_relaxed);
+    uint64_t samples = sampledEvents.load(memory_order_relaxed);
+    stats.sampledNanosPerEvent = samples > 0 ? static_cast<double>(sampledNanos.load(memory_order_relaxed)) / samples : 0.0;
+    stats.maxSampledNanos = static_cast<double>(maxNanos.load(memory_order_relaxed));
+    return stats;
+}
@@ -0,0 +1,134 @@
+#ifndef FRAUD_H
+#define FRAUD_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Events the scoring stage looks at
+enum class ScoredEvent : uint8_t {
+    DEPOSIT,
+    WITHDRAWAL,
+    FAILED_WITHDRAWAL
+};
+
+// Kinds of unusual activity that raise a flag
+enum class FraudSignal : uint8_t {
+    LARGE_DEPOSIT,           // deposit far above the account's running average
+    LARGE_WITHDRAWAL,        // withdrawal far above the account's running average
+    DEPOSIT_ABOVE_QUANTILE,  // deposit a multiple above the account's high quantile
+    FAILED_WITHDRAWAL_BURST  // too many failed withdrawals in a short window
+};
+
+// A raised flag, handed to the scorer's callback
+struct FraudFlag {
+    std::string accountNumber;
+    FraudSignal signal;
+    double amount;
+    double score; // z-score, quantile ratio or failure count, depending on signal
+};
+
+// Scoring thresholds
+struct FraudConfig {
+    double ewmaAlpha = 0.05;           // weight of the newest amount in running averages
+    double zScoreThreshold = 4.0;      // flag amounts this many deviations above average
+    uint32_t warmupEvents = 20;        // events seen before amount flags can fire
+    double quantile = 0.99;            // tracked deposit quantile
+    double quantileMultiplier = 3.0;   // flag deposits this many times the tracked quantile
+    uint32_t failedBurstCount = 5;     // failed withdrawals ...
+    uint32_t failedBurstSeconds = 60;  // ... within this many seconds raise a burst flag
+};
+
+// Exponentially weighted mean and variance of a stream of amounts
+struct EwmaStats {
+    double mean = 0.0;
+    double variance = 0.0;
+    uint64_t count = 0;
+};
+
+// P2Quantile Class
+// Streaming estimate of one quantile using the P-square algorithm: five markers
+// adjusted per observation, so memory stays fixed no matter how many amounts are seen.
+class P2Quantile {
+private:
+    double heights[5];
+    double positions[5];
+    double desired[5];
+    double increments[5];
+    uint64_t count;
+
+public:
+    // Constructor for quantile p (0 < p < 1)
+    explicit P2Quantile(double p = 0.99);
+
+    // Add one observation
+    void add(double x);
+
+    // Current estimate (0 until five observations have been seen)
+    double estimate() const;
+};
+
+// Per-account scoring state, fixed size
+struct AccountRiskState {
+    static const uint32_t MAX_BURST = 16;
+
+    EwmaStats deposits;
+    EwmaStats withdrawals;
+    P2Quantile depositQuantile;
+    int64_t failedWithdrawalTimes[MAX_BURST]; // ring of failure times, milliseconds
+    uint32_t failedHead;
+
+    explicit AccountRiskState(double quantile);
+};
+
+// Counters describing the scoring stage's own cost
+struct FraudStats {
+    uint64_t eventsScored;
+    uint64_t flagsRaised;
+    double sampledNanosPerEvent; // average over sampled events
+    double maxSampledNanos;
+};
+
+// FraudScorer Class
+// Inline scoring stage for Deposit/Withdraw. Each account keeps an
+// AccountRiskState of fixed size (running averages, a quantile estimate and a
+// small ring of failure times), so scoring is O(1) in time and memory per event.
+// Every 1024th event is timed so the stage's overhead can be watched in production.
+class FraudScorer {
+public:
+    typedef std::function<void(const FraudFlag&)> FlagCallback;
+
+private:
+    FraudConfig config;
+    FlagCallback onFlag;
+    std::atomic<uint64_t> eventsScored;
+    std::atomic<uint64_t> flagsRaised;
+    std::atomic<uint64_t> sampledEvents;
+    std::atomic<uint64_t> sampledNanos;
+    std::atomic<uint64_t> maxNanos;
+
+    // Helper method to raise a flag through the callback
+    void raise(const std::string& accountNumber, FraudSignal signal, double amount, double score);
+
+    // Helper method that does the actual scoring
+    void evaluate(AccountRiskState& state, const std::string& accountNumber, ScoredEvent event, double amount);
+
+public:
+    // Constructor with thresholds and the callback that receives flags
+    FraudScorer(const FraudConfig& cfg, FlagCallback callback);
+
+    // Fresh per-account state matching this scorer's config
+    AccountRiskState makeState() const;
+
+    // Score one event against an account's state, then fold it into the state
+    void score(AccountRiskState& state, const std::string& accountNumber, ScoredEvent event, double amount);
+
+    // Snapshot of the stage's counters and measured overhead
+    FraudStats getStats() const;
+};
+
+// Name of a signal for logs and reports
+std::string fraudSignalName(FraudSignal signal);
+
+#endif
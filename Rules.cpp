@@ -0,0 +1,304 @@
+#include "Rules.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <ctime>
+
+using namespace std;
+
+const size_t RuleProgram::MAX_VELOCITY_RULES;
+const uint32_t RuleProgram::MAX_VELOCITY_COUNT;
+
+// Rule names as written in rule files
+static const map<string, RuleKind> RULE_NAMES = {
+    {"MIN_OPENING_BALANCE", RuleKind::MIN_OPENING_BALANCE},
+    {"MIN_BALANCE", RuleKind::MIN_BALANCE},
+    {"OVERDRAFT_LIMIT", RuleKind::OVERDRAFT_LIMIT},
+    {"MAX_WITHDRAWAL", RuleKind::MAX_WITHDRAWAL},
+    {"DAILY_WITHDRAWAL_CAP", RuleKind::DAILY_WITHDRAWAL_CAP},
+    {"VELOCITY_LIMIT", RuleKind::VELOCITY_LIMIT},
+    {"DEPOSIT_MUST_EXCEED_FEE", RuleKind::DEPOSIT_MUST_EXCEED_FEE}
+};
+
+// Wall clock in whole seconds; rules only need second resolution, so use the
+// coarse clock where available (several times cheaper than a precise read)
+static int64_t currentSecond() {
+    #ifdef CLOCK_REALTIME_COARSE
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return static_cast<int64_t>(ts.tv_sec);
+    #else
+        return chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+// Human-readable reason for a failed rule
+string describeRuleFailure(RuleKind kind) {
+    switch (kind) {
+        case RuleKind::MIN_OPENING_BALANCE: return "Initial Balance Below Minimum Opening Balance";
+        case RuleKind::MIN_BALANCE: return "Withdrawal Would Breach Minimum Balance";
+        case RuleKind::OVERDRAFT_LIMIT: return "Debit Amount Exceeded Overdraft Limit";
+        case RuleKind::MAX_WITHDRAWAL: return "Withdrawal Exceeds Single Withdrawal Limit";
+        case RuleKind::DAILY_WITHDRAWAL_CAP: return "Daily Withdrawal Limit Exceeded";
+        case RuleKind::VELOCITY_LIMIT: return "Too Many Withdrawals In Too Short A Time";
+        case RuleKind::DEPOSIT_MUST_EXCEED_FEE: return "Deposit amount must exceed transaction fee";
+        default: return "Rule Check Failed";
+    }
+}
+
+// ============================
+// RuleProgram Class Implementation
+// ============================
+
+RuleProgram::RuleProgram()
+    : openingFloor(0.0), ringCapacity(0), needsClock(false) {
+}
+
+// Compile rules on top of the built-in defaults; later rules of the same kind win
+shared_ptr<const RuleProgram> RuleProgram::compile(const vector<Rule>& rules) {
+    map<RuleKind, double> limits = {
+        {RuleKind::MIN_OPENING_BALANCE, 1000.00},
+        {RuleKind::DEPOSIT_MUST_EXCEED_FEE, 1.0}
+    };
+    map<uint32_t, uint32_t> velocity; // window -> count
+
+    // Overdraft limit and minimum balance are one setting, a bound on -(balance after);
+    // whichever comes later wins, so an account section can replace the default's
+    double balanceBound = 0.0;
+    RuleKind balanceSource = RuleKind::OVERDRAFT_LIMIT;
+
+    for (const auto& rule : rules) {
+        if (rule.kind == RuleKind::VELOCITY_LIMIT) {
+            if (rule.limit < 1 || rule.limit > MAX_VELOCITY_COUNT || rule.window == 0) {
+                throw invalid_argument("VELOCITY_LIMIT needs a count from 1 to 65536 and a window in seconds");
+            }
+            velocity[rule.window] = static_cast<uint32_t>(rule.limit);
+        } else if (rule.kind != RuleKind::NONE) {
+            if (rule.limit < 0) {
+                throw invalid_argument("Rule limits cannot be negative");
+            }
+            if (rule.kind == RuleKind::OVERDRAFT_LIMIT || rule.kind == RuleKind::MIN_BALANCE) {
+                balanceBound = rule.kind == RuleKind::OVERDRAFT_LIMIT ? rule.limit : -rule.limit;
+                balanceSource = rule.kind;
+            } else {
+                limits[rule.kind] = rule.limit;
+            }
+        }
+    }
+    if (velocity.size() > MAX_VELOCITY_RULES) {
+        throw invalid_argument("Too many VELOCITY_LIMIT rules");
+    }
+
+    shared_ptr<RuleProgram> program(new RuleProgram());
+    program->openingFloor = limits[RuleKind::MIN_OPENING_BALANCE];
+
+    program->withdrawalProgram.push_back({NEGATED_BALANCE_AFTER, true, balanceBound, balanceSource});
+
+    if (limits.count(RuleKind::MAX_WITHDRAWAL)) {
+        program->withdrawalProgram.push_back({AMOUNT, true, limits[RuleKind::MAX_WITHDRAWAL], RuleKind::MAX_WITHDRAWAL});
+    }
+    if (limits.count(RuleKind::DAILY_WITHDRAWAL_CAP)) {
+        program->withdrawalProgram.push_back({DAY_TOTAL_AFTER, true, limits[RuleKind::DAILY_WITHDRAWAL_CAP], RuleKind::DAILY_WITHDRAWAL_CAP});
+        program->needsClock = true;
+    }
+    for (const auto& v : velocity) {
+        uint8_t observable = static_cast<uint8_t>(VELOCITY_BASE + program->velocityWindows.size());
+        program->velocityWindows.push_back({v.first, v.second});
+        program->withdrawalProgram.push_back({observable, true, 0.0, RuleKind::VELOCITY_LIMIT});
+        program->ringCapacity = max<size_t>(program->ringCapacity, v.second);
+        program->needsClock = true;
+    }
+
+    if (limits[RuleKind::DEPOSIT_MUST_EXCEED_FEE] != 0.0) {
+        program->depositProgram.push_back({NET_DEPOSIT_SHORTFALL, false, 0.0, RuleKind::DEPOSIT_MUST_EXCEED_FEE});
+    }
+    return program;
+}
+
+// Built-in rules: $1000 opening floor, no overdraft, deposits must exceed the fee
+shared_ptr<const RuleProgram> RuleProgram::defaults() {
+    static const shared_ptr<const RuleProgram> program = compile({});
+    return program;
+}
+
+// Check a withdrawal of amount plus fee; on rejection failed names the rule
+bool RuleProgram::allowWithdrawal(double amount, double fee, double balance, RuleState& state, RuleKind& failed) const {
+    double values[VELOCITY_BASE + MAX_VELOCITY_RULES];
+    values[AMOUNT] = amount;
+    values[NEGATED_BALANCE_AFTER] = -(balance - (amount + fee));
+
+    int64_t now = 0;
+    if (needsClock) {
+        now = currentSecond();
+        if (state.recentWithdrawals.size() != ringCapacity) {
+            state.recentWithdrawals.assign(ringCapacity, numeric_limits<int64_t>::min());
+            state.ringHead = 0;
+        }
+    }
+    state.checkedAt = now;
+
+    double today = (now / 86400 == state.day) ? state.withdrawnToday : 0.0;
+    values[DAY_TOTAL_AFTER] = today + amount;
+
+    // A window is full if the count-th most recent withdrawal is still inside it
+    for (size_t i = 0; i < velocityWindows.size(); ++i) {
+        const VelocityWindow& v = velocityWindows[i];
+        size_t slot = state.ringHead >= v.count ? state.ringHead - v.count : state.ringHead + ringCapacity - v.count;
+        int64_t nth = state.recentWithdrawals[slot];
+        values[VELOCITY_BASE + i] = nth > now - static_cast<int64_t>(v.window) ? 1.0 : 0.0;
+    }
+
+    bool ok = true;
+    for (const auto& instr : withdrawalProgram) {
+        double v = values[instr.observable];
+        ok &= (v < instr.limit) | (instr.inclusive & (v == instr.limit));
+    }
+
+    failed = ok ? RuleKind::NONE : firstFailure(withdrawalProgram, values);
+    return ok;
+}
+
+// Check a deposit of amount against a fee; on rejection failed names the rule
+bool RuleProgram::allowDeposit(double amount, double fee, RuleKind& failed) const {
+    double values[VELOCITY_BASE] = {};
+    values[AMOUNT] = amount;
+    values[NET_DEPOSIT_SHORTFALL] = fee - amount;
+
+    bool ok = true;
+    for (const auto& instr : depositProgram) {
+        double v = values[instr.observable];
+        ok &= (v < instr.limit) | (instr.inclusive & (v == instr.limit));
+    }
+
+    failed = ok ? RuleKind::NONE : firstFailure(depositProgram, values);
+    return ok;
+}
+
+// Check a bank-initiated charge against the balance rules only
+bool RuleProgram::allowCharge(double fee, double balance, RuleKind& failed) const {
+    double negatedBalanceAfter = -(balance - fee);
+    for (const auto& instr : withdrawalProgram) {
+        if (instr.observable == NEGATED_BALANCE_AFTER
+            && !(negatedBalanceAfter < instr.limit || (instr.inclusive && negatedBalanceAfter == instr.limit))) {
+            failed = instr.source;
+            return false;
+        }
+    }
+    failed = RuleKind::NONE;
+    return true;
+}
+
+// Update running totals after a withdrawal that passed allowWithdrawal
+void RuleProgram::recordWithdrawal(double amount, RuleState& state) const {
+    if (!needsClock) {
+        return;
+    }
+    int64_t day = state.checkedAt / 86400;
+    if (day != state.day) {
+        state.day = day;
+        state.withdrawnToday = 0.0;
+    }
+    state.withdrawnToday += amount;
+
+    if (ringCapacity > 0) {
+        state.recentWithdrawals[state.ringHead] = state.checkedAt;
+        state.ringHead = state.ringHead + 1 == ringCapacity ? 0 : state.ringHead + 1;
+    }
+}
+
+// Minimum opening balance
+double RuleProgram::getOpeningFloor() const {
+    return openingFloor;
+}
+
+// Helper method to find the first failing instruction after a fast-path rejection
+RuleKind RuleProgram::firstFailure(const vector<Instruction>& program, const double* values) {
+    for (const auto& instr : program) {
+        double v = values[instr.observable];
+        if (!(v < instr.limit || (instr.inclusive && v == instr.limit))) {
+            return instr.source;
+        }
+    }
+    return RuleKind::NONE;
+}
+
+// ============================
+// RuleBook Class Implementation
+// ============================
+
+// Constructor with built-in defaults only
+RuleBook::RuleBook() : defaultProgram(RuleProgram::defaults()) {
+}
+
+// Load and compile every section of a rule file
+RuleBook RuleBook::loadFromFile(const string& filename) {
+    ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        throw runtime_error("Unable to open rule file: " + filename);
+    }
+
+    vector<Rule> defaultRules;
+    map<string, vector<Rule>> accountRules;
+    vector<Rule>* section = &defaultRules;
+
+    string line;
+    int lineNumber = 0;
+    while (getline(inFile, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+
+        stringstream ss(line);
+        string name;
+        if (!(ss >> name)) {
+            continue;
+        }
+
+        if (name.front() == '[' && name.back() == ']') {
+            string sectionName = name.substr(1, name.size() - 2);
+            section = sectionName == "DEFAULT" ? &defaultRules : &accountRules[sectionName];
+            continue;
+        }
+
+        auto kind = RULE_NAMES.find(name);
+        Rule rule{RuleKind::NONE, 0.0, 0};
+        if (kind == RULE_NAMES.end() || !(ss >> rule.limit)) {
+            throw runtime_error("Invalid rule on line " + to_string(lineNumber) + " of " + filename);
+        }
+        rule.kind = kind->second;
+        if (rule.kind == RuleKind::MIN_OPENING_BALANCE && section != &defaultRules) {
+            throw runtime_error("MIN_OPENING_BALANCE is only allowed in the [DEFAULT] section (line "
+                                + to_string(lineNumber) + " of " + filename + ")");
+        }
+        if (rule.kind == RuleKind::VELOCITY_LIMIT && !(ss >> rule.window)) {
+            throw runtime_error("VELOCITY_LIMIT needs a window in seconds on line " + to_string(lineNumber));
+        }
+        section->push_back(rule);
+    }
+
+    RuleBook book;
+    book.defaultProgram = RuleProgram::compile(defaultRules);
+    for (const auto& entry : accountRules) {
+        vector<Rule> combined = defaultRules;
+        combined.insert(combined.end(), entry.second.begin(), entry.second.end());
+        book.accountPrograms[entry.first] = RuleProgram::compile(combined);
+    }
+    return book;
+}
+
+// Program for an account number, falling back to the [DEFAULT] section
+shared_ptr<const RuleProgram> RuleBook::forAccount(const string& accountNumber) const {
+    auto it = accountPrograms.find(accountNumber);
+    return it != accountPrograms.end() ? it->second : defaultProgram;
+}
+
+// Program from the [DEFAULT] section
+shared_ptr<const RuleProgram> RuleBook::getDefault() const {
+    return defaultProgram;
+}
@@ -0,0 +1,140 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Kinds of limit rule that can be configured for an account
+enum class RuleKind : uint8_t {
+    NONE,
+    MIN_OPENING_BALANCE,     // opening deposit must be at least limit
+    MIN_BALANCE,             // balance after a withdrawal must stay at or above limit
+    OVERDRAFT_LIMIT,         // balance after a withdrawal may go down to -limit
+    MAX_WITHDRAWAL,          // single withdrawal may not exceed limit
+    DAILY_WITHDRAWAL_CAP,    // withdrawals per calendar day (UTC) may not exceed limit
+    VELOCITY_LIMIT,          // at most limit withdrawals in any window of seconds
+    DEPOSIT_MUST_EXCEED_FEE  // deposit must be larger than the transaction fee (limit 1 = on)
+};
+
+// One configured rule as read from a rule file
+struct Rule {
+    RuleKind kind;
+    double limit;
+    uint32_t window; // seconds, VELOCITY_LIMIT only
+};
+
+// Per-account running totals that rules are evaluated against
+struct RuleState {
+    int64_t day = -1;
+    double withdrawnToday = 0.0;
+    std::vector<int64_t> recentWithdrawals; // ring of withdrawal times in seconds
+    size_t ringHead = 0;
+    int64_t checkedAt = 0; // time of the last evaluation, reused when recording
+};
+
+// RuleProgram Class
+// Rules compiled to a flat form. Every rule becomes "observable <= limit" (or "<")
+// over a handful of values computed once per operation. Overdraft limit and minimum
+// balance are one balance-floor setting (the later one wins), so evaluation is a
+// short loop of compares ANDed together with no per-rule branching.
+class RuleProgram {
+public:
+    static const size_t MAX_VELOCITY_RULES = 16;
+    static const uint32_t MAX_VELOCITY_COUNT = 65536;
+
+private:
+    // Values computed per operation; velocity rules use VELOCITY_BASE + index
+    enum Observable : uint8_t {
+        AMOUNT,
+        NEGATED_BALANCE_AFTER,
+        DAY_TOTAL_AFTER,
+        NET_DEPOSIT_SHORTFALL,
+        VELOCITY_BASE
+    };
+
+    struct Instruction {
+        uint8_t observable;
+        bool inclusive;  // <= when true, < when false
+        double limit;
+        RuleKind source; // rule reported when this instruction fails
+    };
+
+    struct VelocityWindow {
+        uint32_t window;
+        uint32_t count;
+    };
+
+    std::vector<Instruction> withdrawalProgram;
+    std::vector<Instruction> depositProgram;
+    std::vector<VelocityWindow> velocityWindows;
+    double openingFloor;
+    size_t ringCapacity;
+    bool needsClock;
+
+    RuleProgram();
+
+    // Helper method to find the first failing instruction after a fast-path rejection
+    static RuleKind firstFailure(const std::vector<Instruction>& program, const double* values);
+
+public:
+    // Compile rules on top of the built-in defaults; later rules of the same kind win
+    static std::shared_ptr<const RuleProgram> compile(const std::vector<Rule>& rules);
+
+    // Built-in rules: $1000 opening floor, no overdraft, deposits must exceed the fee
+    static std::shared_ptr<const RuleProgram> defaults();
+
+    // Check a withdrawal of amount plus fee; on rejection failed names the rule
+    bool allowWithdrawal(double amount, double fee, double balance, RuleState& state, RuleKind& failed) const;
+
+    // Check a deposit of amount against a fee; on rejection failed names the rule
+    bool allowDeposit(double amount, double fee, RuleKind& failed) const;
+
+    // Check a bank-initiated charge (e.g. a maintenance fee) against the balance
+    // rules only; customer limits such as velocity and daily caps don't apply
+    bool allowCharge(double fee, double balance, RuleKind& failed) const;
+
+    // Update running totals after a withdrawal that passed allowWithdrawal
+    void recordWithdrawal(double amount, RuleState& state) const;
+
+    // Minimum opening balance
+    double getOpeningFloor() const;
+};
+
+// RuleBook Class
+// Rule programs loaded from a config file with a [DEFAULT] section and optional
+// per-account sections ([ACC1001]) that add to or override the defaults. An
+// account's OVERDRAFT_LIMIT or MIN_BALANCE replaces either one from [DEFAULT].
+// MIN_OPENING_BALANCE is only accepted in [DEFAULT], since the opening floor is
+// applied when an account is constructed, before its own rules are attached:
+//
+//     [DEFAULT]
+//     MIN_OPENING_BALANCE 1000
+//     [ACC1001]
+//     OVERDRAFT_LIMIT 500
+//     VELOCITY_LIMIT 5 60
+class RuleBook {
+private:
+    std::shared_ptr<const RuleProgram> defaultProgram;
+    std::map<std::string, std::shared_ptr<const RuleProgram>> accountPrograms;
+
+public:
+    // Constructor with built-in defaults only
+    RuleBook();
+
+    // Load and compile every section of a rule file
+    static RuleBook loadFromFile(const std::string& filename);
+
+    // Program for an account number, falling back to the [DEFAULT] section
+    std::shared_ptr<const RuleProgram> forAccount(const std::string& accountNumber) const;
+
+    // Program from the [DEFAULT] section
+    std::shared_ptr<const RuleProgram> getDefault() const;
+};
+
+// Human-readable reason for a failed rule
+std::string describeRuleFailure(RuleKind kind);
+
+#endif
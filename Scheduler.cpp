@@ -0,0 +1,247 @@
+#include "Scheduler.h"
+
+using namespace std;
+
+const TimerWheel::TimerId TimerWheel::NO_TIMER;
+
+// ============================
+// TimerWheel Class Implementation
+// ============================
+
+// Constructor starting the clock at tick 0
+TimerWheel::TimerWheel() : freeList(NO_TIMER), currentTick(0), activeCount(0) {
+    buckets.fill(NO_TIMER);
+}
+
+// Pre-size the slab for an expected number of live timers
+void TimerWheel::reserve(size_t timers) {
+    nodes.reserve(timers);
+}
+
+// Schedule a timer delay ticks from now (at least 1); payload is handed back on expiry
+TimerWheel::TimerId TimerWheel::schedule(uint64_t delay, uint64_t payload) {
+    TimerId id;
+    if (freeList != NO_TIMER) {
+        id = freeList;
+        freeList = nodes[id].next;
+    } else {
+        if (nodes.size() >= NO_TIMER) {
+            throw runtime_error("Timer wheel is full");
+        }
+        id = static_cast<TimerId>(nodes.size());
+        nodes.push_back(TimerNode());
+    }
+
+    nodes[id].expiry = currentTick + (delay == 0 ? 1 : delay);
+    nodes[id].payload = payload;
+    link(id);
+    ++activeCount;
+    return id;
+}
+
+// Cancel a pending timer; returns false if it already fired or was cancelled
+bool TimerWheel::cancel(TimerId id) {
+    if (id >= nodes.size() || nodes[id].bucket == NO_TIMER) {
+        return false;
+    }
+    unlink(id);
+    nodes[id].next = freeList;
+    freeList = id;
+    --activeCount;
+    return true;
+}
+
+// Advance the clock by ticks, calling onExpire(payload) for each timer that fires
+void TimerWheel::advance(uint64_t ticks, const function<void(uint64_t)>& onExpire) {
+    for (uint64_t t = 0; t < ticks; ++t) {
+        ++currentTick;
+
+        // At a level boundary re-file the next bucket of each higher level, top first
+        int top = 0;
+        while (top + 1 < LEVELS && ((currentTick >> (SLOT_BITS * (top + 1))) << (SLOT_BITS * (top + 1))) == currentTick) {
+            ++top;
+        }
+        for (int level = top; level >= 1; --level) {
+            cascade(level);
+        }
+
+        // Detach the due bucket first so callbacks may schedule new timers
+        uint32_t slot = currentTick & (SLOTS - 1);
+        TimerId id = buckets[slot];
+        buckets[slot] = NO_TIMER;
+        while (id != NO_TIMER) {
+            TimerId next = nodes[id].next;
+            uint64_t payload = nodes[id].payload;
+            nodes[id].bucket = NO_TIMER;
+            nodes[id].next = freeList;
+            freeList = id;
+            --activeCount;
+            onExpire(payload);
+            id = next;
+        }
+    }
+}
+
+// Current tick
+uint64_t TimerWheel::now() const {
+    return currentTick;
+}
+
+// Number of pending timers
+size_t TimerWheel::size() const {
+    return activeCount;
+}
+
+// Helper method to file a timer in the bucket matching its distance from now
+void TimerWheel::link(TimerId id) {
+    TimerNode& node = nodes[id];
+    uint64_t delta = node.expiry > currentTick ? node.expiry - currentTick : 0;
+    uint64_t expiry = node.expiry;
+
+    int level = 0;
+    while (level + 1 < LEVELS && delta >= (1ull << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    // Beyond the wheel span: park on the top level and re-file when it cascades
+    if (level == LEVELS - 1 && delta >= (1ull << (SLOT_BITS * LEVELS))) {
+        expiry = currentTick + (1ull << (SLOT_BITS * LEVELS)) - 1;
+    }
+
+    uint32_t slot = (expiry >> (SLOT_BITS * level)) & (SLOTS - 1);
+    node.bucket = level * SLOTS + slot;
+    node.prev = NO_TIMER;
+    node.next = buckets[node.bucket];
+    if (node.next != NO_TIMER) {
+        nodes[node.next].prev = id;
+    }
+    buckets[node.bucket] = id;
+}
+
+// Helper method to remove a timer from its bucket list
+void TimerWheel::unlink(TimerId id) {
+    TimerNode& node = nodes[id];
+    if (node.prev != NO_TIMER) {
+        nodes[node.prev].next = node.next;
+    } else {
+        buckets[node.bucket] = node.next;
+    }
+    if (node.next != NO_TIMER) {
+        nodes[node.next].prev = node.prev;
+    }
+    node.bucket = NO_TIMER;
+}
+
+// Helper method to move every timer in a bucket down to its proper level
+void TimerWheel::cascade(int level) {
+    uint32_t slot = (currentTick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    uint32_t bucket = level * SLOTS + slot;
+    TimerId id = buckets[bucket];
+    buckets[bucket] = NO_TIMER;
+    while (id != NO_TIMER) {
+        TimerId next = nodes[id].next;
+        link(id);
+        id = next;
+    }
+}
+
+// ============================
+// BatchScheduler Class Implementation
+// ============================
+
+// Constructor with the number of accounts processed per chunk
+BatchScheduler::BatchScheduler(size_t accountsPerChunk)
+    : chunkSize(accountsPerChunk == 0 ? 1 : accountsPerChunk) {
+}
+
+// Register an account for batch processing (not owned)
+void BatchScheduler::addAccount(Account* account) {
+    if (account == nullptr) {
+        throw invalid_argument("Cannot schedule a null account");
+    }
+    accounts.push_back(account);
+}
+
+// Add a job that runs over every account each period, first run after firstDelay ticks
+size_t BatchScheduler::addRecurringJob(const string& name, uint64_t period, uint64_t firstDelay,
+                                       const function<void(Account&)>& action) {
+    if (period == 0) {
+        throw invalid_argument("Job period must be at least one tick");
+    }
+    size_t index = jobs.size();
+    uint64_t delay = firstDelay == 0 ? 1 : firstDelay;
+    jobs.push_back(Job{name, period, action, wheel.now() + delay, 0, false, 0});
+    wheel.schedule(delay, index);
+    return index;
+}
+
+// Add daily accrual, monthly interest posting and monthly chequing maintenance fee jobs
+void BatchScheduler::addStandardJobs(double monthlyMaintenanceFee) {
+    addRecurringJob("DAILY_INTEREST_ACCRUAL", TICKS_PER_DAY, TICKS_PER_DAY, [](Account& account) {
+        if (auto* savings = dynamic_cast<SavingsAccount*>(&account)) {
+            savings->AccrueDailyInterest();
+        }
+    });
+    // Posting runs one tick after the month's last accrual has started
+    addRecurringJob("MONTHLY_INTEREST_POSTING", TICKS_PER_MONTH, TICKS_PER_MONTH + 1, [](Account& account) {
+        if (auto* savings = dynamic_cast<SavingsAccount*>(&account)) {
+            savings->PostAccruedInterest();
+        }
+    });
+    addRecurringJob("MONTHLY_MAINTENANCE_FEE", TICKS_PER_MONTH, TICKS_PER_MONTH, [monthlyMaintenanceFee](Account& account) {
+        if (auto* chequing = dynamic_cast<ChequingAccount*>(&account)) {
+            chequing->ChargeMaintenanceFee(monthlyMaintenanceFee);
+        }
+    });
+}
+
+// Advance the scheduler clock, running any chunks that come due
+void BatchScheduler::advance(uint64_t ticks) {
+    wheel.advance(ticks, [this](uint64_t jobIndex) { runChunk(jobIndex); });
+}
+
+// Current scheduler tick
+uint64_t BatchScheduler::now() const {
+    return wheel.now();
+}
+
+// Display each job and how many runs it has completed
+void BatchScheduler::report() const {
+    cout << "\n=== BATCH JOB REPORT ===" << endl;
+    cout << "Scheduler Tick: " << wheel.now() << " (day " << wheel.now() / TICKS_PER_DAY << ")" << endl;
+    cout << "Accounts: " << accounts.size() << endl;
+    for (const auto& job : jobs) {
+        cout << job.name << ": " << job.completedRuns << " runs completed"
+             << (job.running ? " (in progress)" : "") << endl;
+    }
+    cout << "========================" << endl;
+}
+
+// Helper method to run the next chunk of a job when its timer fires
+void BatchScheduler::runChunk(uint64_t jobIndex) {
+    Job& job = jobs[jobIndex];
+    if (!job.running) {
+        job.running = true;
+        job.cursor = 0;
+    }
+
+    // Batch runs touch every account; keep them off the console
+    {
+        ConsoleMute mute;
+        size_t end = min(job.cursor + chunkSize, accounts.size());
+        for (; job.cursor < end; ++job.cursor) {
+            job.action(*accounts[job.cursor]);
+        }
+    }
+
+    if (job.cursor < accounts.size()) {
+        // Yield: pick up the next chunk on the following tick
+        wheel.schedule(1, jobIndex);
+        return;
+    }
+
+    job.running = false;
+    ++job.completedRuns;
+    job.nextStart += job.period;
+    uint64_t delay = job.nextStart > wheel.now() ? job.nextStart - wheel.now() : 1;
+    wheel.schedule(delay, jobIndex);
+}
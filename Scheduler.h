@@ -0,0 +1,121 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "Banking.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+// Scheduler time is counted in ticks of one second
+const uint64_t TICKS_PER_DAY = 86400;
+const uint64_t TICKS_PER_MONTH = 30 * TICKS_PER_DAY;
+
+// TimerWheel Class
+// Hierarchical timer wheel: four levels of 256 slots cover 2^32 ticks, and
+// timers further out are parked on the top level and re-filed when it cascades.
+// Timers live in one slab vector linked by index with a free list, so scheduling
+// and cancelling reuse slots instead of allocating per timer.
+class TimerWheel {
+public:
+    typedef uint32_t TimerId;
+    static const TimerId NO_TIMER = 0xFFFFFFFFu;
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const uint32_t SLOTS = 1u << SLOT_BITS;
+
+    struct TimerNode {
+        uint64_t expiry;
+        uint64_t payload;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t bucket; // level * SLOTS + slot, or NO_TIMER when free
+    };
+
+    std::vector<TimerNode> nodes;
+    std::array<uint32_t, LEVELS * SLOTS> buckets;
+    uint32_t freeList;
+    uint64_t currentTick;
+    size_t activeCount;
+
+    // Helper methods for the intrusive bucket lists
+    void link(TimerId id);
+    void unlink(TimerId id);
+
+    // Helper method to move every timer in a bucket down to its proper level
+    void cascade(int level);
+
+public:
+    // Constructor starting the clock at tick 0
+    TimerWheel();
+
+    // Pre-size the slab for an expected number of live timers
+    void reserve(size_t timers);
+
+    // Schedule a timer delay ticks from now (at least 1); payload is handed back on expiry
+    TimerId schedule(uint64_t delay, uint64_t payload);
+
+    // Cancel a pending timer; returns false if it already fired or was cancelled
+    bool cancel(TimerId id);
+
+    // Advance the clock by ticks, calling onExpire(payload) for each timer that fires
+    void advance(uint64_t ticks, const std::function<void(uint64_t)>& onExpire);
+
+    // Current tick
+    uint64_t now() const;
+
+    // Number of pending timers
+    size_t size() const;
+};
+
+// BatchScheduler Class
+// Drives recurring jobs over every registered account. Each job run walks the
+// accounts in chunks and yields back to the caller between chunks (one chunk per
+// job per tick), so live Deposit/Withdraw traffic interleaves with long runs.
+class BatchScheduler {
+private:
+    struct Job {
+        std::string name;
+        uint64_t period;
+        std::function<void(Account&)> action;
+        uint64_t nextStart;
+        size_t cursor;
+        bool running;
+        uint64_t completedRuns;
+    };
+
+    TimerWheel wheel;
+    std::vector<Account*> accounts;
+    std::vector<Job> jobs;
+    size_t chunkSize;
+
+    // Helper method to run the next chunk of a job when its timer fires
+    void runChunk(uint64_t jobIndex);
+
+public:
+    // Constructor with the number of accounts processed per chunk
+    explicit BatchScheduler(size_t accountsPerChunk = 1000);
+
+    // Register an account for batch processing (not owned)
+    void addAccount(Account* account);
+
+    // Add a job that runs over every account each period, first run after firstDelay ticks
+    size_t addRecurringJob(const std::string& name, uint64_t period, uint64_t firstDelay,
+                           const std::function<void(Account&)>& action);
+
+    // Add daily accrual, monthly interest posting and monthly chequing maintenance fee jobs
+    void addStandardJobs(double monthlyMaintenanceFee);
+
+    // Advance the scheduler clock, running any chunks that come due
+    void advance(uint64_t ticks);
+
+    // Current scheduler tick
+    uint64_t now() const;
+
+    // Display each job and how many runs it has completed
+    void report() const;
+};
+
+#endif
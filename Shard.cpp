@@ -0,0 +1,507 @@
+#include "Shard.h"
+
+#include <algorithm>
+#include <cstring>
+#include <csignal>
+#include <linux/futex.h>
+#include <memory>
+#include <new>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+
+using namespace std;
+
+const size_t ShardChannel::RING_CAPACITY;
+
+// Busy polls, then yields, before a consumer goes to sleep on its ring
+static const unsigned SPIN_LIMIT = 64;
+static const unsigned YIELD_LIMIT = 256;
+
+// Spin briefly, then give the core away while waiting on a ring
+static void backoff(unsigned& spins) {
+    if (++spins > SPIN_LIMIT) {
+        sched_yield();
+    }
+}
+
+// Shared (not process-private) futex calls, since the word lives in a MAP_SHARED mapping
+static void futexWait(atomic<uint32_t>& word, uint32_t expected) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+static void futexWake(atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+// Wait for a ring to have an item: spin, then yield, then sleep until a producer wakes us.
+// The flag is set before the final emptiness check and producers check it after
+// publishing, with a full fence on each side, so a wake-up cannot be missed.
+template <typename Ring>
+static void waitForItem(Ring& ring, unsigned& spins) {
+    if (++spins <= SPIN_LIMIT) {
+        return;
+    }
+    if (spins <= YIELD_LIMIT) {
+        sched_yield();
+        return;
+    }
+    ring.consumerSleeping.store(1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (ring.empty()) {
+        futexWait(ring.consumerSleeping, 1);
+    }
+    ring.consumerSleeping.store(0, memory_order_relaxed);
+}
+
+// Wake a ring's consumer if it went to sleep; call after every successful push
+template <typename Ring>
+static void wakeConsumer(Ring& ring) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (ring.consumerSleeping.load(memory_order_relaxed) != 0) {
+        ring.consumerSleeping.store(0, memory_order_relaxed);
+        futexWake(ring.consumerSleeping);
+    }
+}
+
+// ============================
+// ConsistentHashRing Class Implementation
+// ============================
+
+// Constructor placing virtualNodes points per shard
+ConsistentHashRing::ConsistentHashRing(uint32_t shardCount, uint32_t virtualNodes) {
+    if (shardCount == 0) {
+        throw invalid_argument("At least one shard is required");
+    }
+    points.reserve(static_cast<size_t>(shardCount) * virtualNodes);
+    for (uint32_t shard = 0; shard < shardCount; ++shard) {
+        for (uint32_t v = 0; v < virtualNodes; ++v) {
+            points.emplace_back(hash("shard-" + to_string(shard) + "-" + to_string(v)), shard);
+        }
+    }
+    sort(points.begin(), points.end());
+}
+
+// Shard that owns an account number
+uint32_t ConsistentHashRing::shardFor(const string& accountNumber) const {
+    uint64_t h = hash(accountNumber);
+    auto it = lower_bound(points.begin(), points.end(), make_pair(h, uint32_t(0)));
+    if (it == points.end()) {
+        it = points.begin();
+    }
+    return it->second;
+}
+
+// 64-bit FNV-1a hash used for both points and keys
+uint64_t ConsistentHashRing::hash(const string& key) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    // Final mix so short, similar keys spread across the ring
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+// ============================
+// ShardRouter Class Implementation
+// ============================
+
+// Constructor forks shardCount worker processes
+ShardRouter::ShardRouter(uint32_t shardCount)
+    : ring(shardCount), nextRequestId(1), nextHoldId(1), nextAccountNumber(1000) {
+    cout.flush(); // don't let children inherit buffered output
+
+    for (uint32_t shard = 0; shard < shardCount; ++shard) {
+        void* memory = mmap(nullptr, sizeof(ShardChannel), PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw runtime_error("Unable to map shared memory for shard " + to_string(shard));
+        }
+        ShardChannel* channel = new (memory) ShardChannel;
+        channel->requests.head.store(0);
+        channel->requests.tail.store(0);
+        channel->responses.head.store(0);
+        channel->responses.tail.store(0);
+        channel->requests.consumerSleeping.store(0);
+        channel->responses.consumerSleeping.store(0);
+        channels.push_back(channel);
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw runtime_error("Unable to start worker for shard " + to_string(shard));
+        }
+        if (pid == 0) {
+            runWorker(channel);
+        }
+        workers.push_back(pid);
+    }
+}
+
+// Destructor shuts the workers down and releases shared memory
+ShardRouter::~ShardRouter() {
+    for (uint32_t shard = 0; shard < channels.size(); ++shard) {
+        if (shard < workers.size()) {
+            ShardRequest request = makeRequest(ShardOp::SHUTDOWN, "", 0.0);
+            push(shard, request);
+            waitpid(workers[shard], nullptr, 0);
+        }
+        munmap(channels[shard], sizeof(ShardChannel));
+    }
+}
+
+// Open an account on its owning shard; returns the account number ("" on failure)
+string ShardRouter::openSavings(double initialBalance, double rate) {
+    string account = "ACC" + to_string(nextAccountNumber++);
+    return call(shardFor(account), ShardOp::OPEN_SAVINGS, account, initialBalance, rate).success ? account : "";
+}
+
+string ShardRouter::openChequing(double initialBalance, double fee) {
+    string account = "ACC" + to_string(nextAccountNumber++);
+    return call(shardFor(account), ShardOp::OPEN_CHEQUING, account, initialBalance, fee).success ? account : "";
+}
+
+// Single-account operations routed to the owning shard
+bool ShardRouter::deposit(const string& account, double amount) {
+    return call(shardFor(account), ShardOp::DEPOSIT, account, amount).success;
+}
+
+bool ShardRouter::withdraw(const string& account, double amount) {
+    return call(shardFor(account), ShardOp::WITHDRAW, account, amount).success;
+}
+
+// Deposit / withdraw with a client-supplied operation id
+OperationResult ShardRouter::deposit(const string& account, double amount, const string& operationId) {
+    uint32_t shard = shardFor(account);
+    push(shard, makeRequest(ShardOp::DEPOSIT, account, amount, 0.0, operationId));
+    ShardResponse response = await(shard);
+    return OperationResult{response.success != 0, response.replayed != 0, response.balance};
+}
+
+OperationResult ShardRouter::withdraw(const string& account, double amount, const string& operationId) {
+    uint32_t shard = shardFor(account);
+    push(shard, makeRequest(ShardOp::WITHDRAW, account, amount, 0.0, operationId));
+    ShardResponse response = await(shard);
+    return OperationResult{response.success != 0, response.replayed != 0, response.balance};
+}
+
+double ShardRouter::balance(const string& account) {
+    ShardResponse response = call(shardFor(account), ShardOp::BALANCE, account, 0.0);
+    if (!response.success) {
+        throw invalid_argument("Unknown account: " + account);
+    }
+    return response.balance;
+}
+
+// Move funds between accounts on any shards with two-phase commit
+bool ShardRouter::transfer(const string& from, const string& to, double amount) {
+    return transfer(from, to, amount, "").success;
+}
+
+// Transfer with a client-supplied operation id, deduped by the source shard
+OperationResult ShardRouter::transfer(const string& from, const string& to, double amount,
+                                      const string& operationId) {
+    uint32_t source = shardFor(from);
+    uint32_t target = shardFor(to);
+
+    // Each side gets its own hold id, so both sides can sit on the same shard
+    ShardRequest debit = makeRequest(ShardOp::PREPARE_DEBIT, from, amount, 0.0, operationId);
+    ShardRequest credit = makeRequest(ShardOp::PREPARE_CREDIT, to, amount);
+    debit.holdId = nextHoldId++;
+    credit.holdId = nextHoldId++;
+
+    // Phase 1: both shards vote in parallel (workers reply in order, so this
+    // also works when source == target)
+    push(source, debit);
+    push(target, credit);
+    ShardResponse debitVote = await(source);
+    bool creditReady = await(target).success != 0;
+
+    // A retried id is answered from the source's dedup cache and holds nothing
+    bool debitReady = debitVote.success != 0 && debitVote.replayed == 0;
+
+    ShardRequest finishDebit = makeRequest(ShardOp::ABORT, from, 0.0, 0.0, operationId);
+    ShardRequest finishCredit = makeRequest(ShardOp::ABORT, to, 0.0);
+    finishDebit.holdId = debit.holdId;
+    finishCredit.holdId = credit.holdId;
+
+    // Any no vote (or a replay): release whatever was prepared
+    if (!debitReady || !creditReady) {
+        if (debitReady) {
+            push(source, finishDebit);
+            await(source);
+        }
+        if (creditReady) {
+            push(target, finishCredit);
+            await(target);
+        }
+        if (debitVote.replayed) {
+            return OperationResult{debitVote.success != 0, true, debitVote.balance};
+        }
+        return OperationResult{false, false, debitVote.balance};
+    }
+
+    // Phase 2: commit the debit first (recording the id on the source). A held
+    // credit cannot fail, so the destination is committed only once the funds
+    // have actually left the source
+    finishDebit.op = ShardOp::COMMIT;
+    push(source, finishDebit);
+    ShardResponse debited = await(source);
+
+    finishCredit.op = debited.success ? ShardOp::COMMIT : ShardOp::ABORT;
+    push(target, finishCredit);
+    await(target);
+    return OperationResult{debited.success != 0, false, debited.balance};
+}
+
+// Send many single-account requests without waiting for each reply
+size_t ShardRouter::executeBatch(const vector<ShardRequest>& requests) {
+    size_t successes = 0;
+    size_t outstanding = 0;
+
+    auto drain = [&]() {
+        for (ShardChannel* channel : channels) {
+            ShardResponse response;
+            while (channel->responses.tryPop(response)) {
+                successes += response.success;
+                --outstanding;
+            }
+        }
+    };
+
+    for (ShardRequest request : requests) {
+        uint32_t shard = shardFor(request.account);
+        request.requestId = nextRequestId++;
+        unsigned spins = 0;
+        while (!channels[shard]->requests.tryPush(request)) {
+            drain();
+            backoff(spins);
+        }
+        wakeConsumer(channels[shard]->requests);
+        ++outstanding;
+    }
+
+    unsigned spins = 0;
+    while (outstanding > 0) {
+        drain();
+        if (outstanding > 0) {
+            backoff(spins);
+        }
+    }
+    return successes;
+}
+
+// Shard that owns an account number
+uint32_t ShardRouter::shardFor(const string& account) const {
+    return ring.shardFor(account);
+}
+
+// Number of shards
+uint32_t ShardRouter::shardCount() const {
+    return static_cast<uint32_t>(channels.size());
+}
+
+// Build a request for executeBatch
+ShardRequest ShardRouter::makeRequest(ShardOp op, const string& account, double amount, double param,
+                                      const string& operationId) {
+    if (account.size() >= sizeof(ShardRequest::account)) {
+        throw invalid_argument("Account number too long: " + account);
+    }
+    if (operationId.size() >= sizeof(ShardRequest::operationId)) {
+        throw invalid_argument("Operation id too long: " + operationId);
+    }
+    ShardRequest request{};
+    request.op = op;
+    request.amount = amount;
+    request.param = param;
+    memcpy(request.account, account.c_str(), account.size() + 1);
+    memcpy(request.operationId, operationId.c_str(), operationId.size() + 1);
+    return request;
+}
+
+// Helper method to send a request to a shard
+void ShardRouter::push(uint32_t shard, ShardRequest request) {
+    request.requestId = nextRequestId++;
+    unsigned spins = 0;
+    while (!channels[shard]->requests.tryPush(request)) {
+        backoff(spins);
+    }
+    wakeConsumer(channels[shard]->requests);
+}
+
+// Helper method to wait for a shard's next response (workers reply in order)
+ShardResponse ShardRouter::await(uint32_t shard) {
+    ShardResponse response;
+    unsigned spins = 0;
+    while (!channels[shard]->responses.tryPop(response)) {
+        waitForItem(channels[shard]->responses, spins);
+    }
+    return response;
+}
+
+// Helper method for a synchronous request/response round trip
+ShardResponse ShardRouter::call(uint32_t shard, ShardOp op, const string& account, double amount,
+                                double param) {
+    ShardRequest request = makeRequest(op, account, amount, param);
+    push(shard, request);
+    return await(shard);
+}
+
+// Helper method run by each forked worker; never returns
+void ShardRouter::runWorker(ShardChannel* channel) {
+    prctl(PR_SET_PDEATHSIG, SIGKILL); // don't outlive the router
+
+    ConsoleMute mute;
+    unordered_map<string, unique_ptr<Account>> accounts;
+
+    // Two-phase transfer holds, by hold id (one per side of a transfer)
+    struct Hold {
+        Account* account;
+        double amount; // transfer amount
+        double held;   // amount reserved on the source, including any fee
+        bool debit;
+    };
+    unordered_map<uint64_t, Hold> holds;
+    unordered_map<Account*, double> reserved;
+
+    unsigned spins = 0;
+    while (true) {
+        ShardRequest request;
+        if (!channel->requests.tryPop(request)) {
+            waitForItem(channel->requests, spins);
+            continue;
+        }
+        spins = 0;
+
+        ShardResponse response{request.requestId, 0.0, 0, 0};
+        auto found = accounts.find(request.account);
+        Account* account = found != accounts.end() ? found->second.get() : nullptr;
+        double held = account && reserved.count(account) ? reserved[account] : 0.0;
+
+        switch (request.op) {
+            case ShardOp::OPEN_SAVINGS:
+            case ShardOp::OPEN_CHEQUING:
+                if (!account && request.amount >= Account::getDefaultRules()->getOpeningFloor()) {
+                    if (request.op == ShardOp::OPEN_SAVINGS) {
+                        account = new SavingsAccount(request.amount, request.param, request.account);
+                    } else {
+                        account = new ChequingAccount(request.amount, request.param, request.account);
+                    }
+                    accounts[request.account].reset(account);
+                    response.success = 1;
+                    response.balance = request.amount;
+                }
+                break;
+
+            case ShardOp::DEPOSIT:
+                if (account) {
+                    OperationResult result = account->Deposit(request.amount, request.operationId);
+                    response.success = result.success;
+                    response.replayed = result.replayed;
+                    response.balance = result.balance;
+                }
+                break;
+
+            case ShardOp::WITHDRAW: {
+                if (!account) {
+                    break;
+                }
+                // A retry is answered from the dedup cache even if funds are now held
+                OperationResult result;
+                if (request.operationId[0] != '\0'
+                    && Account::operationCache().lookup(request.account, request.operationId, result)) {
+                    result.replayed = true;
+                } else if (held == 0.0 || account->CanWithdraw(held + request.amount)) {
+                    // Funds held for a pending transfer are not available
+                    result = account->Withdraw(request.amount, request.operationId);
+                } else {
+                    break;
+                }
+                response.success = result.success;
+                response.replayed = result.replayed;
+                response.balance = result.balance;
+                break;
+            }
+
+            case ShardOp::BALANCE:
+                if (account) {
+                    response.success = 1;
+                    response.balance = account->GetBalance();
+                }
+                break;
+
+            case ShardOp::PREPARE_DEBIT: {
+                if (!account) {
+                    break;
+                }
+                response.balance = account->GetBalance();
+
+                // A transfer id already committed here is answered from the dedup cache
+                OperationResult result;
+                if (request.operationId[0] != '\0'
+                    && Account::operationCache().lookup(request.account, request.operationId, result)) {
+                    response.success = result.success;
+                    response.replayed = 1;
+                    response.balance = result.balance;
+                } else if (account->CanWithdraw(held + request.amount)) {
+                    auto* chequing = dynamic_cast<ChequingAccount*>(account);
+                    double hold = request.amount + (chequing ? chequing->GetTransactionFee() : 0.0);
+                    holds[request.holdId] = Hold{account, request.amount, hold, true};
+                    reserved[account] += hold;
+                    response.success = 1;
+                }
+                break;
+            }
+
+            case ShardOp::PREPARE_CREDIT:
+                if (account && account->CanDeposit(request.amount)) {
+                    holds[request.holdId] = Hold{account, request.amount, 0.0, false};
+                    response.success = 1;
+                }
+                break;
+
+            case ShardOp::COMMIT:
+            case ShardOp::ABORT: {
+                auto hold = holds.find(request.holdId);
+                if (hold == holds.end()) {
+                    break;
+                }
+                Hold h = hold->second;
+                holds.erase(hold);
+                if (h.debit && (reserved[h.account] -= h.held) <= 0.0) {
+                    reserved.erase(h.account);
+                }
+                if (request.op == ShardOp::ABORT) {
+                    response.success = 1;
+                } else if (h.debit) {
+                    // Withdraw records the transfer's operation id, if any, in the dedup cache
+                    OperationResult result = h.account->Withdraw(h.amount, request.operationId);
+                    response.success = result.success;
+                    response.balance = result.balance;
+                } else {
+                    response.success = h.account->Deposit(h.amount, "").success;
+                }
+                break;
+            }
+
+            case ShardOp::SHUTDOWN:
+                response.success = 1;
+                channel->responses.tryPush(response);
+                wakeConsumer(channel->responses);
+                _exit(0);
+        }
+
+        unsigned pushSpins = 0;
+        while (!channel->responses.tryPush(response)) {
+            backoff(pushSpins);
+        }
+        wakeConsumer(channel->responses);
+    }
+}
@@ -0,0 +1,189 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+// Multi-process sharding. Uses fork() and shared anonymous mappings, so this
+// module is Linux/POSIX only.
+
+#include "Banking.h"
+
+#include <atomic>
+#include <cstdint>
+#include <sys/types.h>
+
+// ConsistentHashRing Class
+// Maps account numbers to shards. Each shard owns many virtual points on a 64-bit
+// ring; an account belongs to the first point at or after its hash, so adding a
+// shard only moves the accounts that land on the new shard's points.
+class ConsistentHashRing {
+private:
+    std::vector<std::pair<uint64_t, uint32_t>> points; // (hash, shard), sorted by hash
+
+public:
+    // Constructor placing virtualNodes points per shard
+    ConsistentHashRing(uint32_t shardCount, uint32_t virtualNodes = 128);
+
+    // Shard that owns an account number
+    uint32_t shardFor(const std::string& accountNumber) const;
+
+    // 64-bit FNV-1a hash used for both points and keys
+    static uint64_t hash(const std::string& key);
+};
+
+// Operations a router can send to a shard worker
+enum class ShardOp : uint8_t {
+    OPEN_SAVINGS,    // param = interest rate
+    OPEN_CHEQUING,   // param = transaction fee
+    DEPOSIT,
+    WITHDRAW,
+    BALANCE,
+    PREPARE_DEBIT,   // two-phase transfer: hold funds on the source account
+    PREPARE_CREDIT,  // two-phase transfer: check the destination can accept them
+    COMMIT,          // commit / abort one side; each side has its own hold id
+    ABORT,
+    SHUTDOWN
+};
+
+// Fixed-size request copied through shared memory
+struct ShardRequest {
+    uint64_t requestId;
+    uint64_t holdId;     // two-phase transfer operations only; one per side of a transfer
+    double amount;
+    double param;
+    ShardOp op;
+    char account[23];
+    char operationId[40]; // client-supplied id for DEPOSIT/WITHDRAW/PREPARE_DEBIT/COMMIT ("" = none)
+};
+
+// Fixed-size response copied through shared memory
+struct ShardResponse {
+    uint64_t requestId;
+    double balance;
+    uint8_t success;
+    uint8_t replayed; // served from the worker's dedup cache
+};
+
+// ShmRing Class
+// Single-producer single-consumer ring placed in shared memory. Head and tail
+// sit on their own cache lines so the router and worker do not false-share. A
+// consumer that stays idle past its spin budget sets consumerSleeping and waits
+// on it as a futex; producers wake it after pushing.
+template <typename T, size_t Capacity>
+struct ShmRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Ring capacity must be a power of two");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory rings need lock-free atomics");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared memory rings need lock-free atomics");
+
+    alignas(64) std::atomic<uint64_t> head; // next slot to read, written by the consumer
+    alignas(64) std::atomic<uint64_t> tail; // next slot to write, written by the producer
+    alignas(64) std::atomic<uint32_t> consumerSleeping; // futex word, 1 while the consumer waits
+    alignas(64) T slots[Capacity];
+
+    bool empty() const {
+        return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+    }
+
+    bool tryPush(const T& item) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// Request and response rings shared between the router and one shard worker
+struct ShardChannel {
+    static const size_t RING_CAPACITY = 4096;
+    ShmRing<ShardRequest, RING_CAPACITY> requests;
+    ShmRing<ShardResponse, RING_CAPACITY> responses;
+};
+
+// ShardRouter Class
+// Front end that forks one worker process per shard and forwards operations to
+// the owning shard over shared-memory rings. Each worker owns its accounts
+// outright, so no locks are needed; idle workers sleep rather than spin.
+// Deposits, withdrawals and transfers may carry an operation id, which the
+// owning worker (the source's, for a transfer) dedups like
+// Account::Deposit/Withdraw do. Transfers between accounts use
+// two-phase commit with the router as coordinator (there is no durable
+// coordinator log; a router crash mid-transfer leaves the hold in place on the
+// source shard).
+class ShardRouter {
+private:
+    ConsistentHashRing ring;
+    std::vector<ShardChannel*> channels;
+    std::vector<pid_t> workers;
+    uint64_t nextRequestId;
+    uint64_t nextHoldId;
+    int nextAccountNumber;
+
+    // Helper methods to exchange messages with a shard
+    void push(uint32_t shard, ShardRequest request);
+    ShardResponse await(uint32_t shard);
+    ShardResponse call(uint32_t shard, ShardOp op, const std::string& account, double amount,
+                       double param = 0.0);
+
+    // Helper method run by each forked worker; never returns
+    static void runWorker(ShardChannel* channel);
+
+public:
+    // Constructor forks shardCount worker processes
+    explicit ShardRouter(uint32_t shardCount);
+
+    // Destructor shuts the workers down and releases shared memory
+    ~ShardRouter();
+
+    ShardRouter(const ShardRouter&) = delete;
+    ShardRouter& operator=(const ShardRouter&) = delete;
+
+    // Open an account on its owning shard; returns the account number ("" on failure)
+    std::string openSavings(double initialBalance, double rate);
+    std::string openChequing(double initialBalance, double fee);
+
+    // Single-account operations routed to the owning shard
+    bool deposit(const std::string& account, double amount);
+    bool withdraw(const std::string& account, double amount);
+    double balance(const std::string& account);
+
+    // Deposit / withdraw with a client-supplied operation id; a retried id
+    // returns the original result instead of posting twice
+    OperationResult deposit(const std::string& account, double amount, const std::string& operationId);
+    OperationResult withdraw(const std::string& account, double amount, const std::string& operationId);
+
+    // Move funds between accounts on any shards with two-phase commit
+    bool transfer(const std::string& from, const std::string& to, double amount);
+
+    // Transfer with a client-supplied operation id, deduped in the source account's
+    // id space: once committed, a retried id returns the original result (balance is
+    // the source's) without preparing again. Declined transfers are not recorded.
+    OperationResult transfer(const std::string& from, const std::string& to, double amount,
+                             const std::string& operationId);
+
+    // Send many single-account requests without waiting for each reply;
+    // returns the number that succeeded
+    size_t executeBatch(const std::vector<ShardRequest>& requests);
+
+    // Shard that owns an account number
+    uint32_t shardFor(const std::string& account) const;
+
+    // Number of shards
+    uint32_t shardCount() const;
+
+    // Build a request for executeBatch
+    static ShardRequest makeRequest(ShardOp op, const std::string& account, double amount, double param = 0.0,
+                                    const std::string& operationId = "");
+};
+
+#endif
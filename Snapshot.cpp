@@ -0,0 +1,185 @@
+#include "Snapshot.h"
+
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Helper to write the balance report shared by console and file output
+static void writeBalanceReport(ostream& out, const SnapshotReader& reader) {
+    out << "Accounts: " << reader.size() << endl;
+    out << "--------------------" << endl;
+    double total = 0.0;
+    for (uint32_t i = 0; i < reader.size(); ++i) {
+        BalanceView view = reader.read(i);
+        total += view.balance;
+        out << view.accountNumber << "  " << left << setw(9) << view.accountType << right
+            << " $" << fixed << setprecision(2) << view.balance
+            << "  (" << view.transactionCount << " transactions)" << endl;
+    }
+    out << "--------------------" << endl;
+    out << "Total Balances: $" << fixed << setprecision(2) << total << endl;
+}
+
+// ============================
+// BalanceSnapshot Class Implementation
+// ============================
+
+// Constructor creates (or replaces) the named segment with room for capacity accounts
+BalanceSnapshot::BalanceSnapshot(const string& segmentName, uint32_t capacity)
+    : name(segmentName), header(nullptr), slots(nullptr),
+      mappedSize(sizeof(SnapshotHeader) + static_cast<size_t>(capacity) * sizeof(SnapshotSlot)) {
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw runtime_error("Unable to create balance snapshot: " + name);
+    }
+    if (ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw runtime_error("Unable to size balance snapshot: " + name);
+    }
+    void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw runtime_error("Unable to map balance snapshot: " + name);
+    }
+
+    // The segment starts zero-filled; set the header last so readers never see a half-built one
+    header = new (memory) SnapshotHeader;
+    slots = reinterpret_cast<SnapshotSlot*>(header + 1);
+    header->capacity = capacity;
+    header->count.store(0, memory_order_relaxed);
+    header->magic = SNAPSHOT_MAGIC;
+}
+
+// Destructor unmaps and removes the segment
+BalanceSnapshot::~BalanceSnapshot() {
+    munmap(header, mappedSize);
+    shm_unlink(name.c_str());
+}
+
+// ============================
+// SnapshotReader Class Implementation
+// ============================
+
+// Constructor maps the named segment read-only
+SnapshotReader::SnapshotReader(const string& segmentName)
+    : header(nullptr), slots(nullptr), mappedSize(0), indexed(0) {
+    int fd = shm_open(segmentName.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw runtime_error("Balance snapshot not found: " + segmentName);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+        close(fd);
+        throw runtime_error("Balance snapshot is not ready: " + segmentName);
+    }
+    mappedSize = static_cast<size_t>(info.st_size);
+    void* memory = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        throw runtime_error("Unable to map balance snapshot: " + segmentName);
+    }
+
+    header = static_cast<const SnapshotHeader*>(memory);
+    slots = reinterpret_cast<const SnapshotSlot*>(header + 1);
+    if (header->magic != SNAPSHOT_MAGIC
+        || mappedSize < sizeof(SnapshotHeader) + static_cast<size_t>(header->capacity) * sizeof(SnapshotSlot)) {
+        munmap(memory, mappedSize);
+        throw runtime_error("Not a balance snapshot: " + segmentName);
+    }
+}
+
+// Destructor unmaps the segment
+SnapshotReader::~SnapshotReader() {
+    munmap(const_cast<SnapshotHeader*>(header), mappedSize);
+}
+
+// Read one slot consistently
+BalanceView SnapshotReader::read(uint32_t slot) const {
+    if (slot >= size()) {
+        throw out_of_range("Snapshot slot out of range");
+    }
+    const SnapshotSlot& s = slots[slot];
+    BalanceView view;
+    view.accountNumber = string(s.accountNumber, strnlen(s.accountNumber, sizeof(s.accountNumber)));
+    view.accountType = string(s.accountType, strnlen(s.accountType, sizeof(s.accountType)));
+
+    // Retry while the writer is mid-update or updated underneath us
+    while (true) {
+        uint64_t before = s.sequence.load(memory_order_acquire);
+        if (before & 1) {
+            sched_yield();
+            continue;
+        }
+        view.balance = s.balance.load(memory_order_relaxed);
+        view.transactionCount = s.transactionCount.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (s.sequence.load(memory_order_relaxed) == before) {
+            return view;
+        }
+    }
+}
+
+// Look up an account's balance; returns false if it is not in the snapshot
+bool SnapshotReader::findBalance(const string& accountNumber, BalanceView& view) {
+    refreshIndex();
+    auto it = index.find(accountNumber);
+    if (it == index.end()) {
+        return false;
+    }
+    view = read(it->second);
+    return true;
+}
+
+// Number of accounts in the snapshot
+uint32_t SnapshotReader::size() const {
+    return header->count.load(memory_order_acquire);
+}
+
+// Display every balance in the snapshot
+void SnapshotReader::report() const {
+    cout << "\n=== BALANCE SNAPSHOT REPORT ===" << endl;
+    writeBalanceReport(cout, *this);
+    cout << "===============================" << endl;
+}
+
+// Save the balance report to a file
+bool SnapshotReader::saveReportToFile(const string& filename) const {
+    try {
+        ofstream outFile(filename);
+
+        if (!outFile.is_open()) {
+            throw runtime_error("Unable to open file for writing: " + filename);
+        }
+
+        outFile << "=== TRAJJ BANKING SERVICES - BALANCE SNAPSHOT REPORT ===" << endl;
+        writeBalanceReport(outFile, *this);
+        outFile << "========================================================" << endl;
+        outFile.close();
+
+        cout << "\nBalance report successfully saved to: " << filename << endl;
+        return true;
+
+    } catch (const exception& e) {
+        cout << "Error saving report to file: " << e.what() << endl;
+        return false;
+    }
+}
+
+// Helper method to index slots published since the last lookup
+void SnapshotReader::refreshIndex() {
+    uint32_t count = size();
+    for (; indexed < count; ++indexed) {
+        const SnapshotSlot& s = slots[indexed];
+        index[string(s.accountNumber, strnlen(s.accountNumber, sizeof(s.accountNumber)))] = indexed;
+    }
+}
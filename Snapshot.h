@@ -0,0 +1,138 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+// Shared-memory balance snapshot. Segments are POSIX shared memory objects, so
+// creating or opening one is Linux/POSIX only; publishing is plain atomics.
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One account's published balance, on its own cache line. Readers use the
+// sequence number as a seqlock: odd while the writer is mid-update.
+struct alignas(64) SnapshotSlot {
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory slots need lock-free atomics");
+    static_assert(std::atomic<double>::is_always_lock_free, "Shared memory slots need lock-free atomics");
+
+    std::atomic<uint64_t> sequence;
+    std::atomic<double> balance;
+    std::atomic<uint64_t> transactionCount;
+    char accountNumber[24];
+    char accountType[16];
+};
+static_assert(sizeof(SnapshotSlot) == 64, "Snapshot slots must fill exactly one cache line");
+
+// Segment header, followed by capacity slots
+struct alignas(64) SnapshotHeader {
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared memory headers need lock-free atomics");
+
+    uint64_t magic;
+    uint32_t capacity;
+    std::atomic<uint32_t> count; // slots published so far
+};
+
+// A consistent copy of one slot
+struct BalanceView {
+    std::string accountNumber;
+    std::string accountType;
+    double balance;
+    uint64_t transactionCount;
+};
+
+const uint64_t SNAPSHOT_MAGIC = 0x54524A4A534E4150ull; // "TRJJSNAP"
+
+// BalanceSnapshot Class
+// Writer side of a shared-memory balance view. Accounts attached to it publish
+// their balance after every logged transaction; other threads and local processes
+// read balances from the segment instead of touching the live Account objects.
+// There must be a single writer.
+class BalanceSnapshot {
+private:
+    std::string name;
+    SnapshotHeader* header;
+    SnapshotSlot* slots;
+    size_t mappedSize;
+
+public:
+    // Constructor creates (or replaces) the named segment with room for capacity accounts
+    BalanceSnapshot(const std::string& segmentName, uint32_t capacity);
+
+    // Destructor unmaps and removes the segment
+    ~BalanceSnapshot();
+
+    BalanceSnapshot(const BalanceSnapshot&) = delete;
+    BalanceSnapshot& operator=(const BalanceSnapshot&) = delete;
+
+    // Reserve a slot for an account; returns the slot index
+    uint32_t addAccount(const std::string& accountNumber, const std::string& accountType) {
+        uint32_t index = header->count.load(std::memory_order_relaxed);
+        if (index >= header->capacity) {
+            throw std::runtime_error("Balance snapshot is full");
+        }
+        SnapshotSlot& slot = slots[index];
+        strncpy(slot.accountNumber, accountNumber.c_str(), sizeof(slot.accountNumber) - 1);
+        strncpy(slot.accountType, accountType.c_str(), sizeof(slot.accountType) - 1);
+        header->count.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    // Publish a new balance for a slot
+    void publish(uint32_t index, double balance, uint64_t transactionCount) {
+        SnapshotSlot& slot = slots[index];
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.balance.store(balance, std::memory_order_relaxed);
+        slot.transactionCount.store(transactionCount, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Get the segment name
+    const std::string& getName() const { return name; }
+};
+
+// SnapshotReader Class
+// Read-only mapping of a balance snapshot, usable from any local process.
+class SnapshotReader {
+private:
+    const SnapshotHeader* header;
+    const SnapshotSlot* slots;
+    size_t mappedSize;
+    std::unordered_map<std::string, uint32_t> index; // account number -> slot
+    uint32_t indexed;
+
+    // Helper method to index slots published since the last lookup
+    void refreshIndex();
+
+public:
+    // Constructor maps the named segment read-only
+    explicit SnapshotReader(const std::string& segmentName);
+
+    // Destructor unmaps the segment
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    // Read one slot consistently
+    BalanceView read(uint32_t slot) const;
+
+    // Look up an account's balance; returns false if it is not in the snapshot
+    bool findBalance(const std::string& accountNumber, BalanceView& view);
+
+    // Number of accounts in the snapshot
+    uint32_t size() const;
+
+    // Display every balance in the snapshot
+    void report() const;
+
+    // Save the balance report to a file
+    bool saveReportToFile(const std::string& filename = "balances.txt") const;
+};
+
+#endif
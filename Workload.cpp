@@ -0,0 +1,339 @@
+#include "Workload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+// ============================
+// WorkloadGenerator Class Implementation
+// ============================
+
+// Constructor builds the account mix and popularity table from the config
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& cfg)
+    : config(cfg), rng(cfg.seed) {
+    if (config.accountCount == 0) {
+        throw invalid_argument("Workload must have at least one account");
+    }
+
+    // Popularity of rank r is proportional to 1 / (r + 1)^skew
+    zipfCdf.resize(config.accountCount);
+    double total = 0.0;
+    for (size_t r = 0; r < config.accountCount; ++r) {
+        total += 1.0 / pow(static_cast<double>(r + 1), config.zipfSkew);
+        zipfCdf[r] = total;
+    }
+    for (auto& c : zipfCdf) {
+        c /= total;
+    }
+
+    // Spread hot ranks across account indexes (Fisher-Yates on our own draws)
+    rankToAccount.resize(config.accountCount);
+    for (size_t i = 0; i < config.accountCount; ++i) {
+        rankToAccount[i] = static_cast<uint32_t>(i);
+    }
+    for (size_t i = config.accountCount - 1; i > 0; --i) {
+        size_t j = static_cast<size_t>(nextUniform() * (i + 1));
+        swap(rankToAccount[i], rankToAccount[j]);
+    }
+
+    savingsFlags.resize(config.accountCount);
+    for (size_t i = 0; i < config.accountCount; ++i) {
+        savingsFlags[i] = nextUniform() < config.savingsRatio;
+    }
+}
+
+// Generate the full operation stream
+vector<WorkloadOperation> WorkloadGenerator::generate() {
+    vector<WorkloadOperation> operations;
+    operations.reserve(config.operationCount);
+
+    double depositEdge = config.depositRatio;
+    double transferEdge = depositEdge + config.transferRatio;
+    double inquiryEdge = transferEdge + config.inquiryRatio;
+
+    for (size_t i = 0; i < config.operationCount; ++i) {
+        WorkloadOperation op{OperationKind::WITHDRAWAL, nextAccount(), 0, 0.0};
+
+        double pick = nextUniform();
+        if (pick < depositEdge) {
+            op.kind = OperationKind::DEPOSIT;
+        } else if (pick < transferEdge) {
+            op.kind = OperationKind::TRANSFER;
+        } else if (pick < inquiryEdge) {
+            op.kind = OperationKind::BALANCE_INQUIRY;
+        }
+
+        if (op.kind == OperationKind::TRANSFER) {
+            op.target = nextAccount();
+            if (op.target == op.account && config.accountCount > 1) {
+                op.target = static_cast<uint32_t>((op.account + 1) % config.accountCount);
+            }
+        }
+
+        // Amounts between $5.00 and $500.00 in whole cents
+        op.amount = floor((5.0 + nextUniform() * 495.0) * 100.0) / 100.0;
+
+        // Debits meant to be declined ask for far more than any account holds
+        bool debit = op.kind == OperationKind::WITHDRAWAL || op.kind == OperationKind::TRANSFER;
+        if (debit && nextUniform() < config.declineRate) {
+            op.amount = config.openingBalance * 1000.0;
+        }
+
+        operations.push_back(op);
+    }
+    return operations;
+}
+
+// True if the account at this index is a savings account
+bool WorkloadGenerator::isSavings(size_t account) const {
+    return savingsFlags.at(account);
+}
+
+// Get the config this generator was built from
+const WorkloadConfig& WorkloadGenerator::getConfig() const {
+    return config;
+}
+
+// Save an operation stream as CSV (kind,account,target,amount), preceded by its config
+bool WorkloadGenerator::saveToFile(const vector<WorkloadOperation>& operations, const WorkloadConfig& config,
+                                   const string& filename) {
+    ofstream outFile(filename);
+    if (!outFile.is_open()) {
+        cout << "Error: Unable to open file for writing: " << filename << endl;
+        return false;
+    }
+
+    outFile << setprecision(17);
+    outFile << "# seed=" << config.seed << "\n";
+    outFile << "# accountCount=" << config.accountCount << "\n";
+    outFile << "# operationCount=" << operations.size() << "\n";
+    outFile << "# zipfSkew=" << config.zipfSkew << "\n";
+    outFile << "# savingsRatio=" << config.savingsRatio << "\n";
+    outFile << "# depositRatio=" << config.depositRatio << "\n";
+    outFile << "# transferRatio=" << config.transferRatio << "\n";
+    outFile << "# inquiryRatio=" << config.inquiryRatio << "\n";
+    outFile << "# declineRate=" << config.declineRate << "\n";
+    outFile << "# openingBalance=" << config.openingBalance << "\n";
+    outFile << "# interestRate=" << config.interestRate << "\n";
+    outFile << "# transactionFee=" << config.transactionFee << "\n";
+    outFile << "kind,account,target,amount" << "\n";
+    outFile << fixed << setprecision(2);
+    for (const auto& op : operations) {
+        outFile << static_cast<int>(op.kind) << "," << op.account << ","
+                << op.target << "," << op.amount << "\n";
+    }
+    return static_cast<bool>(outFile);
+}
+
+// Load an operation stream saved by saveToFile, restoring its config. Files
+// without config lines leave config as passed in.
+vector<WorkloadOperation> WorkloadGenerator::loadFromFile(const string& filename, WorkloadConfig& config) {
+    ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        throw runtime_error("Unable to open workload file: " + filename);
+    }
+
+    vector<WorkloadOperation> operations;
+    string line;
+
+    // Config lines, then the CSV header
+    while (getline(inFile, line) && line.compare(0, 2, "# ") == 0) {
+        size_t equals = line.find('=');
+        if (equals == string::npos) {
+            throw runtime_error("Malformed workload setting: " + line);
+        }
+        string key = line.substr(2, equals - 2);
+        string value = line.substr(equals + 1);
+
+        if (key == "seed") config.seed = stoull(value);
+        else if (key == "accountCount") config.accountCount = stoul(value);
+        else if (key == "operationCount") config.operationCount = stoul(value);
+        else if (key == "zipfSkew") config.zipfSkew = stod(value);
+        else if (key == "savingsRatio") config.savingsRatio = stod(value);
+        else if (key == "depositRatio") config.depositRatio = stod(value);
+        else if (key == "transferRatio") config.transferRatio = stod(value);
+        else if (key == "inquiryRatio") config.inquiryRatio = stod(value);
+        else if (key == "declineRate") config.declineRate = stod(value);
+        else if (key == "openingBalance") config.openingBalance = stod(value);
+        else if (key == "interestRate") config.interestRate = stod(value);
+        else if (key == "transactionFee") config.transactionFee = stod(value);
+        else throw runtime_error("Unknown workload setting: " + key);
+    }
+
+    while (getline(inFile, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        int kind;
+        char comma;
+        WorkloadOperation op{};
+        stringstream ss(line);
+        if (!(ss >> kind >> comma >> op.account >> comma >> op.target >> comma >> op.amount)
+            || kind < 0 || kind > static_cast<int>(OperationKind::BALANCE_INQUIRY)) {
+            throw runtime_error("Malformed workload line: " + line);
+        }
+        if (op.account >= config.accountCount
+            || (kind == static_cast<int>(OperationKind::TRANSFER) && op.target >= config.accountCount)) {
+            throw runtime_error("Workload line refers to an account beyond the " + to_string(config.accountCount)
+                                + " configured: " + line);
+        }
+        op.kind = static_cast<OperationKind>(kind);
+        operations.push_back(op);
+    }
+    return operations;
+}
+
+// Helper method to draw a uniform double in [0, 1)
+double WorkloadGenerator::nextUniform() {
+    return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Helper method to draw an account index following the Zipfian skew
+uint32_t WorkloadGenerator::nextAccount() {
+    double u = nextUniform();
+    size_t rank = static_cast<size_t>(upper_bound(zipfCdf.begin(), zipfCdf.end(), u) - zipfCdf.begin());
+    if (rank >= zipfCdf.size()) {
+        rank = zipfCdf.size() - 1;
+    }
+    return rankToAccount[rank];
+}
+
+// ============================
+// ReplayReport Implementation
+// ============================
+
+// Print the summary report
+void ReplayReport::print(ostream& out) const {
+    out << "\n=== WORKLOAD REPLAY REPORT ===" << endl;
+    out << "Operations: " << operations << " (" << declined << " declined)" << endl;
+    out << "Elapsed: " << fixed << setprecision(3) << seconds << " s" << endl;
+    out << "Throughput: " << fixed << setprecision(0) << throughput << " ops/s" << endl;
+    out << "Latency (ns): p50 " << p50 << "  p90 " << p90 << "  p99 " << p99
+        << "  p99.9 " << p999 << "  max " << max << endl;
+    out << "==============================" << endl;
+}
+
+// ============================
+// WorkloadReplayer Class Implementation
+// ============================
+
+// Constructor opens the accounts described by the generator
+WorkloadReplayer::WorkloadReplayer(const WorkloadGenerator& generator) {
+    const WorkloadConfig& config = generator.getConfig();
+    ConsoleMute mute;
+
+    accounts.reserve(config.accountCount);
+    for (size_t i = 0; i < config.accountCount; ++i) {
+        if (generator.isSavings(i)) {
+            accounts.emplace_back(new SavingsAccount(config.openingBalance, config.interestRate));
+        } else {
+            accounts.emplace_back(new ChequingAccount(config.openingBalance, config.transactionFee));
+        }
+    }
+}
+
+// Replay the stream; targetOpsPerSecond <= 0 means maximum speed
+ReplayReport WorkloadReplayer::run(const vector<WorkloadOperation>& operations, double targetOpsPerSecond) {
+    ReplayReport report;
+    vector<double> latencies;
+    latencies.reserve(operations.size());
+
+    ConsoleMute mute;
+    bool paced = targetOpsPerSecond > 0.0;
+    chrono::duration<double> interval(paced ? 1.0 / targetOpsPerSecond : 0.0);
+    auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < operations.size(); ++i) {
+        auto opStart = chrono::steady_clock::now();
+        if (paced) {
+            auto scheduled = start + chrono::duration_cast<chrono::steady_clock::duration>(interval * static_cast<double>(i));
+            if (scheduled > opStart) {
+                this_thread::sleep_until(scheduled);
+            }
+            opStart = scheduled;
+        }
+
+        if (!apply(operations[i])) {
+            ++report.declined;
+        }
+
+        latencies.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - opStart).count());
+    }
+
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report.operations = operations.size();
+    report.throughput = report.seconds > 0.0 ? report.operations / report.seconds : 0.0;
+
+    if (!latencies.empty()) {
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p) {
+            return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+        };
+        report.p50 = percentile(0.50);
+        report.p90 = percentile(0.90);
+        report.p99 = percentile(0.99);
+        report.p999 = percentile(0.999);
+        report.max = latencies.back();
+    }
+    return report;
+}
+
+// Get an opened account by workload index
+Account& WorkloadReplayer::getAccount(size_t index) {
+    return *accounts.at(index);
+}
+
+// Give every account its program from a rule book (its own section, or [DEFAULT])
+void WorkloadReplayer::applyRules(const RuleBook& book) {
+    for (auto& account : accounts) {
+        account->setRules(book.forAccount(account->GetAccountNumber()));
+    }
+}
+
+// Publish every account's balance to a shared-memory snapshot
+void WorkloadReplayer::attachSnapshot(BalanceSnapshot& snapshot) {
+    for (auto& account : accounts) {
+        account->attachSnapshot(snapshot);
+    }
+}
+
+// Stop every account publishing to its snapshot
+void WorkloadReplayer::detachSnapshot() {
+    for (auto& account : accounts) {
+        account->detachSnapshot();
+    }
+}
+
+// Score every account's deposits and withdrawals with a fraud scorer
+void WorkloadReplayer::attachFraudScorer(shared_ptr<FraudScorer> scorer) {
+    for (auto& account : accounts) {
+        account->attachFraudScorer(scorer);
+    }
+}
+
+// Helper method to apply one operation; returns false if it was declined
+bool WorkloadReplayer::apply(const WorkloadOperation& operation) {
+    Account& account = *accounts.at(operation.account);
+
+    switch (operation.kind) {
+        case OperationKind::DEPOSIT:
+            return account.Deposit(operation.amount, "").success;
+
+        case OperationKind::WITHDRAWAL:
+            return account.Withdraw(operation.amount, "").success;
+
+        case OperationKind::TRANSFER:
+            // No transfer API exists; a transfer is a debit followed by a credit
+            if (!account.Withdraw(operation.amount, "").success) {
+                return false;
+            }
+            return accounts.at(operation.target)->Deposit(operation.amount, "").success;
+
+        case OperationKind::BALANCE_INQUIRY:
+            account.GetBalance();
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,133 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "Banking.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+// Kinds of operation a workload stream can contain
+enum class OperationKind : uint8_t {
+    DEPOSIT,
+    WITHDRAWAL,
+    TRANSFER,
+    BALANCE_INQUIRY
+};
+
+// One generated operation; accounts are indexes into the replayed account set
+struct WorkloadOperation {
+    OperationKind kind;
+    uint32_t account;
+    uint32_t target; // destination account for TRANSFER, otherwise unused
+    double amount;
+};
+
+// Knobs for a synthetic workload; the same config and seed always give the same stream
+struct WorkloadConfig {
+    uint64_t seed = 42;
+    size_t accountCount = 1000;
+    size_t operationCount = 100000;
+    double zipfSkew = 1.0;        // 0 = uniform, larger = hotter hot accounts
+    double savingsRatio = 0.5;    // fraction of accounts that are savings accounts
+    double depositRatio = 0.4;    // fraction of operations that are deposits
+    double transferRatio = 0.1;   // fraction of operations that are transfers
+    double inquiryRatio = 0.1;    // fraction of operations that are balance inquiries
+    double declineRate = 0.05;    // fraction of withdrawals/transfers sized to be declined
+    double openingBalance = 5000.00;
+    double interestRate = 2.5;
+    double transactionFee = 1.00;
+};
+
+// WorkloadGenerator Class
+// Produces seeded, reproducible operation streams. Random numbers come straight
+// from mt19937_64 (whose output is fixed by the standard) rather than the
+// std distributions, so a seed replays identically across compilers.
+class WorkloadGenerator {
+private:
+    WorkloadConfig config;
+    std::mt19937_64 rng;
+    std::vector<double> zipfCdf;      // cumulative popularity by account rank
+    std::vector<uint32_t> rankToAccount; // hot ranks are spread over account indexes
+    std::vector<bool> savingsFlags;
+
+    // Helper method to draw a uniform double in [0, 1)
+    double nextUniform();
+
+    // Helper method to draw an account index following the Zipfian skew
+    uint32_t nextAccount();
+
+public:
+    // Constructor builds the account mix and popularity table from the config
+    explicit WorkloadGenerator(const WorkloadConfig& cfg);
+
+    // Generate the full operation stream
+    std::vector<WorkloadOperation> generate();
+
+    // True if the account at this index is a savings account
+    bool isSavings(size_t account) const;
+
+    // Get the config this generator was built from
+    const WorkloadConfig& getConfig() const;
+
+    // Save / load an operation stream as CSV (kind,account,target,amount). The
+    // generating config is written as "# key=value" lines ahead of the CSV header
+    // and restored on load, so the stream replays against the same account set.
+    static bool saveToFile(const std::vector<WorkloadOperation>& operations, const WorkloadConfig& config,
+                           const std::string& filename);
+    static std::vector<WorkloadOperation> loadFromFile(const std::string& filename, WorkloadConfig& config);
+};
+
+// Throughput and latency summary of one replay
+struct ReplayReport {
+    size_t operations = 0;
+    size_t declined = 0;
+    double seconds = 0.0;
+    double throughput = 0.0; // operations per second
+    double p50 = 0.0;        // latencies in nanoseconds
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+
+    // Print the summary report
+    void print(std::ostream& out) const;
+};
+
+// WorkloadReplayer Class
+// Opens one account per workload index and feeds an operation stream into the
+// Account API, either as fast as possible or paced to a target rate. When paced,
+// latency is measured from each operation's scheduled start so a stall is not
+// hidden by the operations queued behind it.
+class WorkloadReplayer {
+private:
+    std::vector<std::unique_ptr<Account>> accounts;
+
+    // Helper method to apply one operation; returns false if it was declined
+    bool apply(const WorkloadOperation& operation);
+
+public:
+    // Constructor opens the accounts described by the generator
+    explicit WorkloadReplayer(const WorkloadGenerator& generator);
+
+    // Replay the stream; targetOpsPerSecond <= 0 means maximum speed
+    ReplayReport run(const std::vector<WorkloadOperation>& operations, double targetOpsPerSecond = 0.0);
+
+    // Get an opened account by workload index
+    Account& getAccount(size_t index);
+
+    // Give every account its program from a rule book (its own section, or [DEFAULT])
+    void applyRules(const RuleBook& book);
+
+    // Publish every account's balance to a shared-memory snapshot; the snapshot
+    // must outlive the replayer, or be detached first
+    void attachSnapshot(BalanceSnapshot& snapshot);
+
+    // Stop every account publishing to its snapshot
+    void detachSnapshot();
+
+    // Score every account's deposits and withdrawals with a fraud scorer
+    void attachFraudScorer(std::shared_ptr<FraudScorer> scorer);
+};
+
+#endif
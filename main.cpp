@@ -7,13 +7,14 @@ int main() {
     // Create accounts with exception handling
     double initialBalance;
     double interestRate, transactionFee;
+    double minimumBalance = Account::getDefaultRules()->getOpeningFloor();
     
     cout << "Welcome to Trajj Banking Services" << endl;
     
     // Get initial balance with error handling
     while (true) {
         try {
-            cout << "Please Enter Initial Account Balance (minimum $1000.00): $";
+            cout << "Please Enter Initial Account Balance (minimum $" << fixed << setprecision(2) << minimumBalance << "): $";
             cin >> initialBalance;
             
             if (cin.fail()) {
@@ -22,8 +23,10 @@ int main() {
                 throw runtime_error("Invalid input. Please enter a numeric value.");
             }
             
-            if (initialBalance < 1000.00) {
-                throw invalid_argument("Initial balance must be at least $1000.00");
+            if (initialBalance < minimumBalance) {
+                stringstream ss;
+                ss << "Initial balance must be at least $" << fixed << setprecision(2) << minimumBalance;
+                throw invalid_argument(ss.str());
             }
             
             break;
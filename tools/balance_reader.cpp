@@ -0,0 +1,53 @@
+#include "../Snapshot.h"
+
+#include <chrono>
+#include <iomanip>
+
+using namespace std;
+
+// Reads balances from a shared-memory snapshot published by another process.
+// Usage: balance_reader SEGMENT [ACCOUNT | --save FILE | --bench N]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: balance_reader SEGMENT [ACCOUNT | --save FILE | --bench N]" << endl;
+        return 1;
+    }
+
+    try {
+        SnapshotReader reader(argv[1]);
+        string arg = argc > 2 ? argv[2] : "";
+
+        if (arg.empty()) {
+            reader.report();
+        } else if (arg == "--save" && argc > 3) {
+            return reader.saveReportToFile(argv[3]) ? 0 : 1;
+        } else if (arg == "--bench" && argc > 3) {
+            // Time consistent reads across every slot while the writer keeps running
+            size_t reads = stoul(argv[3]);
+            uint32_t count = reader.size();
+            if (count == 0) {
+                throw runtime_error("Snapshot has no accounts yet");
+            }
+            double total = 0.0;
+            auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < reads; ++i) {
+                total += reader.read(static_cast<uint32_t>(i % count)).balance;
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "Snapshot reads: " << reads << " at " << fixed << setprecision(1)
+                 << seconds * 1e9 / reads << " ns/read (checksum " << setprecision(2) << total << ")" << endl;
+        } else {
+            BalanceView view;
+            if (!reader.findBalance(arg, view)) {
+                cout << "Account " << arg << " not found in snapshot." << endl;
+                return 1;
+            }
+            cout << view.accountNumber << " (" << view.accountType << ") Balance: $"
+                 << fixed << setprecision(2) << view.balance << endl;
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "../BulkLoader.h"
+
+#include <random>
+
+using namespace std;
+
+// Display command line options
+static void displayUsage() {
+    cout << "Usage:" << endl;
+    cout << "  bulk_load FILE [threads]          load a CSV or binary seed file and report accounts/s" << endl;
+    cout << "  bulk_load --generate N FILE       write a CSV seed file with N accounts" << endl;
+    cout << "  bulk_load --convert CSV BIN       convert a CSV seed file to the binary format" << endl;
+}
+
+// Bulk provisioning front end
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        displayUsage();
+        return 1;
+    }
+
+    try {
+        string command = argv[1];
+
+        if (command == "--generate" && argc > 3) {
+            size_t count = stoul(argv[2]);
+            ofstream outFile(argv[3]);
+            if (!outFile.is_open()) {
+                throw runtime_error(string("Unable to open file for writing: ") + argv[3]);
+            }
+            mt19937_64 rng(42);
+            outFile << "type,accountNumber,openingBalance,rateOrFee" << "\n";
+            outFile << fixed << setprecision(2);
+            for (size_t i = 0; i < count; ++i) {
+                bool savings = rng() & 1;
+                double opening = 1000.0 + static_cast<double>(rng() % 10000000) / 100.0;
+                double rateOrFee = savings ? static_cast<double>(rng() % 500) / 100.0 : static_cast<double>(rng() % 300) / 100.0;
+                outFile << (savings ? "S" : "C") << ",MIG" << 1000000 + i << "," << opening << "," << rateOrFee << "\n";
+            }
+            cout << "Seed file with " << count << " accounts written to: " << argv[3] << endl;
+            return 0;
+        }
+
+        if (command == "--convert" && argc > 3) {
+            BulkLoader loader;
+            vector<string> errors;
+            vector<AccountSeed> seeds = loader.parseCsv(argv[2], errors);
+            for (const auto& error : errors) {
+                cout << "Skipped " << error << endl;
+            }
+            if (!BulkLoader::writeBinary(seeds, argv[3])) {
+                return 1;
+            }
+            cout << seeds.size() << " records converted to: " << argv[3] << endl;
+            return 0;
+        }
+
+        BulkLoader loader(argc > 2 ? static_cast<unsigned>(stoul(argv[2])) : 0);
+        BulkLoadResult result = loader.load(command);
+        result.print(cout);
+
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        displayUsage();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "../Banking.h"
+
+using namespace std;
+
+// Measures the overhead of the operation id dedup cache at a given id volume,
+// both on the bare cache and through Deposit/Withdraw with operation ids.
+// Usage: dedup_bench [ids] [capacity]
+int main(int argc, char* argv[]) {
+    size_t ids = argc > 1 ? stoul(argv[1]) : 2000000;
+    size_t capacity = argc > 2 ? stoul(argv[2]) : 1000000;
+
+    OperationDedupCache cache(capacity, chrono::hours(1));
+    vector<string> accounts, operations;
+    accounts.reserve(ids);
+    operations.reserve(ids);
+    for (size_t i = 0; i < ids; ++i) {
+        accounts.push_back("ACC" + to_string(1000 + i % 5000));
+        operations.push_back("op-" + to_string(i));
+    }
+
+    OperationResult result{true, false, 0.0};
+
+    // Record every id (first delivery of each request)
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < ids; ++i) {
+        cache.record(accounts[i], operations[i], result);
+    }
+    double recordSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Look every id up again (retries); ids older than capacity have been evicted
+    size_t hits = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < ids; ++i) {
+        OperationResult cached;
+        if (cache.lookup(accounts[i], operations[i], cached)) {
+            ++hits;
+        }
+    }
+    double lookupSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Through the Account API: plain operations, first deliveries with ids, then retries
+    size_t accountOps = min<size_t>(ids, 1000000);
+    Account::operationCache().clear();
+    ChequingAccount account(1e12, 0.0, "BENCH");
+    double plainSeconds, firstSeconds, retrySeconds;
+    {
+        ConsoleMute mute;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < accountOps; ++i) {
+            if (i & 1) account.Withdraw(1.0); else account.Deposit(1.0);
+        }
+        plainSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < accountOps; ++i) {
+            if (i & 1) account.Withdraw(1.0, operations[i]); else account.Deposit(1.0, operations[i]);
+        }
+        firstSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < accountOps; ++i) {
+            if (i & 1) account.Withdraw(1.0, operations[i]); else account.Deposit(1.0, operations[i]);
+        }
+        retrySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    cout << "=== OPERATION DEDUP CACHE BENCHMARK ===" << endl;
+    cout << "Operation ids: " << ids << " (capacity " << capacity << ")" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Record: " << recordSeconds * 1e9 / ids << " ns/op" << endl;
+    cout << "Lookup: " << lookupSeconds * 1e9 / ids << " ns/op (" << hits << " hits)" << endl;
+    cout << "Sustainable record rate: " << setprecision(0)
+         << ids / recordSeconds * 3600.0 / 1e6 << " million ids/hour" << endl;
+    cout << "Entries retained: " << cache.size() << endl;
+    cout << setprecision(1);
+    cout << "Deposit/Withdraw without id: " << plainSeconds * 1e9 / accountOps << " ns/op" << endl;
+    cout << "Deposit/Withdraw with new id: " << firstSeconds * 1e9 / accountOps << " ns/op" << endl;
+    cout << "Deposit/Withdraw retried id: " << retrySeconds * 1e9 / accountOps << " ns/op" << endl;
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "../Workload.h"
+
+using namespace std;
+
+// Display command line options
+static void displayUsage() {
+    cout << "Usage: replay [options]" << endl;
+    cout << "  --seed N        random seed (default 42)" << endl;
+    cout << "  --accounts N    number of accounts (default 1000)" << endl;
+    cout << "  --ops N         number of operations (default 100000)" << endl;
+    cout << "  --skew S        Zipfian skew, 0 = uniform (default 1.0)" << endl;
+    cout << "  --savings R     fraction of savings accounts (default 0.5)" << endl;
+    cout << "  --deposit R     fraction of deposits (default 0.4)" << endl;
+    cout << "  --transfer R    fraction of transfers (default 0.1)" << endl;
+    cout << "  --inquiry R     fraction of balance inquiries (default 0.1)" << endl;
+    cout << "  --decline R     fraction of debits sized to be declined (default 0.05)" << endl;
+    cout << "  --rate OPS      target operations per second (default: max speed)" << endl;
+    cout << "  --save FILE     write the generated stream to FILE" << endl;
+    cout << "  --load FILE     replay a stream saved with --save (its saved settings override the options above)" << endl;
+    cout << "  --rules FILE    apply a rule file ([DEFAULT] plus per-account sections) to the accounts" << endl;
+    cout << "  --snapshot NAME publish balances to shared memory segment NAME (e.g. /trajj_balances)" << endl;
+}
+
+// Generates a seeded workload and replays it against the Account API
+int main(int argc, char* argv[]) {
+    WorkloadConfig config;
+    double rate = 0.0;
+    string saveFile, loadFile, rulesFile, snapshotName;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--help") {
+                displayUsage();
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + arg);
+            }
+            string value = argv[++i];
+
+            if (arg == "--seed") config.seed = stoull(value);
+            else if (arg == "--accounts") config.accountCount = stoul(value);
+            else if (arg == "--ops") config.operationCount = stoul(value);
+            else if (arg == "--skew") config.zipfSkew = stod(value);
+            else if (arg == "--savings") config.savingsRatio = stod(value);
+            else if (arg == "--deposit") config.depositRatio = stod(value);
+            else if (arg == "--transfer") config.transferRatio = stod(value);
+            else if (arg == "--inquiry") config.inquiryRatio = stod(value);
+            else if (arg == "--decline") config.declineRate = stod(value);
+            else if (arg == "--rate") rate = stod(value);
+            else if (arg == "--save") saveFile = value;
+            else if (arg == "--load") loadFile = value;
+            else if (arg == "--rules") rulesFile = value;
+            else if (arg == "--snapshot") snapshotName = value;
+            else throw invalid_argument("Unknown option " + arg);
+        }
+
+        // A saved stream carries the config it was generated with, which replaces the command line's
+        vector<WorkloadOperation> operations;
+        if (!loadFile.empty()) {
+            operations = WorkloadGenerator::loadFromFile(loadFile, config);
+            cout << "Loaded " << operations.size() << " operations over " << config.accountCount
+                 << " accounts (seed " << config.seed << ") from: " << loadFile << endl;
+        }
+        WorkloadGenerator generator(config);
+        if (loadFile.empty()) {
+            operations = generator.generate();
+        }
+
+        if (!saveFile.empty() && WorkloadGenerator::saveToFile(operations, config, saveFile)) {
+            cout << "Workload saved to: " << saveFile << endl;
+        }
+
+        // The [DEFAULT] section also sets the opening floor, so it must be in place before accounts open
+        RuleBook rules;
+        if (!rulesFile.empty()) {
+            rules = RuleBook::loadFromFile(rulesFile);
+            Account::setDefaultRules(rules.getDefault());
+            cout << "Rules loaded from: " << rulesFile << endl;
+        }
+
+        // Declared ahead of the replayer so the snapshot outlives the accounts publishing to it
+        unique_ptr<BalanceSnapshot> snapshot;
+        WorkloadReplayer replayer(generator);
+        replayer.applyRules(rules);
+        if (!snapshotName.empty()) {
+            snapshot.reset(new BalanceSnapshot(snapshotName, static_cast<uint32_t>(config.accountCount)));
+            replayer.attachSnapshot(*snapshot);
+            cout << "Publishing balances to snapshot: " << snapshotName << endl;
+        }
+
+        ReplayReport report = replayer.run(operations, rate);
+        report.print(cout);
+
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        displayUsage();
+        return 1;
+    }
+    return 0;
+}
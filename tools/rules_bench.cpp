@@ -0,0 +1,68 @@
+#include "../Banking.h"
+
+using namespace std;
+
+// Measures the cost of evaluating a compiled rule program per withdrawal, with
+// accepted and declined checks timed separately.
+// Usage: rules_bench [checks]
+int main(int argc, char* argv[]) {
+    size_t checks = argc > 1 ? stoul(argv[1]) : 10000000;
+
+    // Dozens of configured rules: repeated limits plus sixteen velocity windows
+    vector<Rule> rules = {
+        {RuleKind::OVERDRAFT_LIMIT, 500.0, 0},
+        {RuleKind::MIN_BALANCE, 100.0, 0},
+        {RuleKind::MAX_WITHDRAWAL, 10000.0, 0},
+        {RuleKind::MAX_WITHDRAWAL, 5000.0, 0},
+        {RuleKind::DAILY_WITHDRAWAL_CAP, 1e12, 0},
+        {RuleKind::DEPOSIT_MUST_EXCEED_FEE, 1.0, 0}
+    };
+    for (uint32_t i = 0; i < RuleProgram::MAX_VELOCITY_RULES; ++i) {
+        rules.push_back({RuleKind::VELOCITY_LIMIT, 10.0 * (i + 1), 60 * (i + 1)});
+    }
+    shared_ptr<const RuleProgram> program = RuleProgram::compile(rules);
+    shared_ptr<const RuleProgram> baseline = RuleProgram::defaults();
+
+    RuleKind failed;
+    size_t baselineAccepted = 0, accepted = 0, declined = 0;
+
+    RuleState baselineState;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < checks; ++i) {
+        baselineAccepted += baseline->allowWithdrawal(1.0 + (i & 63), 1.0, 1e9, baselineState, failed);
+    }
+    double baselineSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Accept path: nothing is recorded, so the velocity windows stay empty and every check passes
+    RuleState openState;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < checks; ++i) {
+        accepted += program->allowWithdrawal(1.0 + (i & 63), 1.0, 1e9, openState, failed);
+    }
+    double acceptSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Recording an accepted withdrawal into the running totals
+    RuleState recordState;
+    program->allowWithdrawal(1.0, 1.0, 1e9, recordState, failed);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < checks; ++i) {
+        program->recordWithdrawal(1.0 + (i & 63), recordState);
+    }
+    double recordSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Decline path: the recorded withdrawals have filled every velocity window
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < checks; ++i) {
+        declined += !program->allowWithdrawal(1.0 + (i & 63), 1.0, 1e9, recordState, failed);
+    }
+    double declineSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "=== RULE ENGINE BENCHMARK ===" << endl;
+    cout << "Checks per run: " << checks << endl;
+    cout << fixed << setprecision(1);
+    cout << "Default rules: " << baselineSeconds * 1e9 / checks << " ns/check (" << baselineAccepted << " accepted)" << endl;
+    cout << rules.size() << " rules, accepted: " << acceptSeconds * 1e9 / checks << " ns/check (" << accepted << " accepted)" << endl;
+    cout << rules.size() << " rules, record: " << recordSeconds * 1e9 / checks << " ns/withdrawal" << endl;
+    cout << rules.size() << " rules, declined: " << declineSeconds * 1e9 / checks << " ns/check (" << declined << " declined)" << endl;
+    return 0;
+}
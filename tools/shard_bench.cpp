@@ -0,0 +1,107 @@
+#include "../Shard.h"
+#include "../Workload.h"
+
+using namespace std;
+
+// Replays the same seeded workload against 1 to maxShards shard processes and
+// reports throughput at each size, plus two-phase transfer latency. At each size
+// it also checks that transfers (same-shard and cross-shard) conserve the total
+// balance, release every hold and are not posted again when retried with the same
+// operation id; the exit status is 1 if any check fails.
+// Usage: shard_bench [accounts] [operations] [maxShards]
+int main(int argc, char* argv[]) {
+    WorkloadConfig config;
+    config.accountCount = argc > 1 ? stoul(argv[1]) : 10000;
+    config.operationCount = argc > 2 ? stoul(argv[2]) : 200000;
+    uint32_t maxShards = argc > 3 ? static_cast<uint32_t>(stoul(argv[3])) : 16;
+    config.transferRatio = 0.0; // transfers are measured separately below
+
+    WorkloadGenerator generator(config);
+    vector<WorkloadOperation> operations = generator.generate();
+
+    cout << "=== SHARD SCALING BENCHMARK ===" << endl;
+    cout << "Accounts: " << config.accountCount << "  Operations: " << operations.size() << endl;
+    cout << "Shards  Ops/s        Transfer us  Committed/aborted  Conserved (same/cross-shard transfers)" << endl;
+    bool allConserved = true;
+
+    for (uint32_t shards = 1; shards <= maxShards; shards *= 2) {
+        ShardRouter router(shards);
+
+        // Open accounts in bulk; workload index i maps to the i-th opened account
+        vector<string> accounts;
+        vector<ShardRequest> opens;
+        for (size_t i = 0; i < config.accountCount; ++i) {
+            accounts.push_back("ACC" + to_string(1000 + i));
+            opens.push_back(generator.isSavings(i)
+                ? ShardRouter::makeRequest(ShardOp::OPEN_SAVINGS, accounts.back(), config.openingBalance, config.interestRate)
+                : ShardRouter::makeRequest(ShardOp::OPEN_CHEQUING, accounts.back(), config.openingBalance, config.transactionFee));
+        }
+        router.executeBatch(opens);
+
+        vector<ShardRequest> requests;
+        requests.reserve(operations.size());
+        for (const auto& op : operations) {
+            ShardOp shardOp = op.kind == OperationKind::DEPOSIT ? ShardOp::DEPOSIT
+                            : op.kind == OperationKind::WITHDRAWAL ? ShardOp::WITHDRAW
+                            : ShardOp::BALANCE;
+            requests.push_back(ShardRouter::makeRequest(shardOp, accounts[op.account], op.amount));
+        }
+
+        auto start = chrono::steady_clock::now();
+        router.executeBatch(requests);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // Two-phase transfers between neighbouring accounts (mostly cross-shard). The
+        // amount is above the chequing fee, since a deposit must exceed it; any that
+        // still abort are counted so the latency isn't read as full commits only
+        const size_t transfers = 2000;
+        size_t committed = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < transfers; ++i) {
+            committed += router.transfer(accounts[i % accounts.size()], accounts[(i + 1) % accounts.size()],
+                                         config.transactionFee + 4.00);
+        }
+        double transferSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // Conservation: fee-free savings accounts, random pairs (including an account with
+        // itself). Every transfer is sent twice with the same id; the retry must not post again
+        const size_t pool = 64;
+        vector<string> savers;
+        vector<ShardRequest> saverOpens;
+        for (size_t i = 0; i < pool; ++i) {
+            savers.push_back("SAVER" + to_string(i));
+            saverOpens.push_back(ShardRouter::makeRequest(ShardOp::OPEN_SAVINGS, savers.back(), 5000.00, 0.0));
+        }
+        router.executeBatch(saverOpens);
+        mt19937_64 rng(shards);
+        size_t sameShard = 0, crossShard = 0;
+        bool replayed = true;
+        for (size_t i = 0; i < transfers; ++i) {
+            const string& from = savers[rng() % pool];
+            const string& to = savers[rng() % pool];
+            double amount = static_cast<double>(rng() % 2000);
+            string operationId = "xfer-" + to_string(i);
+            if (router.transfer(from, to, amount, operationId).success) {
+                replayed &= router.transfer(from, to, amount, operationId).replayed;
+                ++(router.shardFor(from) == router.shardFor(to) ? sameShard : crossShard);
+            }
+        }
+        double total = 0.0;
+        bool released = true;
+        for (const auto& account : savers) {
+            double balance = router.balance(account);
+            total += balance;
+            // Nothing may still be held, so the full balance can be withdrawn
+            released &= balance == 0.0 || router.withdraw(account, balance);
+        }
+        bool conserved = released && replayed && fabs(total - 5000.00 * pool) < 0.005;
+        allConserved &= conserved;
+
+        cout << setw(6) << shards << "  " << setw(11) << fixed << setprecision(0)
+             << operations.size() / seconds << "  " << setw(11) << setprecision(1)
+             << transferSeconds * 1e6 / transfers << "  " << setw(8) << committed << "/" << left << setw(8)
+             << transfers - committed << right << "  " << (conserved ? "yes" : "NO") << " ("
+             << sameShard << "/" << crossShard << ")" << endl;
+    }
+    return allConserved ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+#include "../Scheduler.h"
+
+#include <random>
+
+using namespace std;
+
+// Schedules millions of timers on the wheel, then runs the clock until all fire.
+// Usage: timer_bench [timers] [maxDelayTicks]
+int main(int argc, char* argv[]) {
+    size_t timers = argc > 1 ? stoul(argv[1]) : 5000000;
+    uint64_t maxDelay = argc > 2 ? stoull(argv[2]) : 2 * TICKS_PER_DAY;
+
+    TimerWheel wheel;
+    wheel.reserve(timers);
+    mt19937_64 rng(7);
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < timers; ++i) {
+        wheel.schedule(1 + rng() % maxDelay, i);
+    }
+    double scheduleSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t fired = 0;
+    uint64_t late = 0;
+    start = chrono::steady_clock::now();
+    wheel.advance(maxDelay, [&](uint64_t) { ++fired; });
+    double runSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    late = wheel.size();
+
+    cout << "=== TIMER WHEEL BENCHMARK ===" << endl;
+    cout << "Timers: " << timers << " over " << maxDelay << " ticks" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Schedule: " << scheduleSeconds * 1e9 / timers << " ns/timer" << endl;
+    cout << "Expire: " << runSeconds * 1e9 / timers << " ns/timer (" << fired << " fired, "
+         << late << " still pending)" << endl;
+    return late == 0 && fired == timers ? 0 : 1;
+}